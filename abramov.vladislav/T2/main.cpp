@@ -1,9 +1,9 @@
 #include <iostream>
 #include <vector>
 #include <iterator>
-#include <limits>
 #include <algorithm>
 #include "datastruct.hpp"
+#include "record_scanner.hpp"
 #include "stream_guard.hpp"
 
 int main()
@@ -12,14 +12,11 @@ int main()
   StreamGuard in(std::cin);
   StreamGuard out(std::cout);
   std::vector< DataStruct > data;
-  while (!std::cin.eof())
+  RecordScanner scanner(std::cin.rdbuf());
+  DataStruct record;
+  while (scanner.next(record))
   {
-    std::copy(std::istream_iterator< DataStruct >{ std::cin }, std::istream_iterator< DataStruct >{}, std::back_inserter(data));
-    if (!std::cin)
-    {
-      std::cin.clear();
-      std::cin.ignore(std::numeric_limits< std::streamsize >::max(), '\n');
-    }
+    data.push_back(std::move(record));
   }
   std::sort(data.begin(), data.end());
   std::copy(data.begin(), data.end(), std::ostream_iterator< DataStruct >{ std::cout, "\n" });
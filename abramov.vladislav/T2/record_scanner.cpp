@@ -0,0 +1,407 @@
+#include "record_scanner.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+  bool isSpace(char c) noexcept
+  {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+  }
+
+  bool isDigit(char c) noexcept
+  {
+    return c >= '0' && c <= '9';
+  }
+
+  bool fastDouble(const std::string &literal, double &value) noexcept
+  {
+    constexpr double powers[] = {
+      1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    constexpr int max_power = 22;
+    constexpr int max_digits = 15;
+    const char *c = literal.c_str();
+    bool negative = *c == '-';
+    c += (*c == '-' || *c == '+');
+    unsigned long long mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool found_digit = false;
+    for (; isDigit(*c); ++c)
+    {
+      found_digit = true;
+      if (mantissa != 0 || *c != '0')
+      {
+        mantissa = mantissa * 10 + (*c - '0');
+        ++digits;
+      }
+    }
+    if (*c == '.')
+    {
+      for (++c; isDigit(*c); ++c)
+      {
+        found_digit = true;
+        if (mantissa != 0 || *c != '0')
+        {
+          mantissa = mantissa * 10 + (*c - '0');
+          ++digits;
+        }
+        --exponent;
+      }
+    }
+    if (!found_digit || *c != '\0' || digits > max_digits || exponent < -max_power)
+    {
+      return false;
+    }
+    value = static_cast< double >(mantissa) / powers[-exponent];
+    value = negative ? -value : value;
+    return true;
+  }
+}
+
+abramov::RecordScanner::RecordScanner(std::streambuf *source, size_t block_size):
+  source_(source),
+  buf_(block_size),
+  block_size_(block_size),
+  pos_(0),
+  cur_(0),
+  end_(0),
+  eof_(false),
+  number_()
+{}
+
+bool abramov::RecordScanner::next(DataStruct &data)
+{
+  while (true)
+  {
+    Status status = record(data);
+    if (status == Status::OK)
+    {
+      pos_ = cur_;
+      return true;
+    }
+    else if (status == Status::MORE)
+    {
+      refill();
+    }
+    else
+    {
+      pos_ = cur_;
+      if (!skipLine())
+      {
+        return false;
+      }
+    }
+  }
+}
+
+bool abramov::RecordScanner::refill()
+{
+  if (eof_)
+  {
+    return false;
+  }
+  size_t kept = end_ - pos_;
+  std::memmove(buf_.data(), buf_.data() + pos_, kept);
+  pos_ = 0;
+  end_ = kept;
+  if (buf_.size() - end_ < block_size_)
+  {
+    buf_.resize(end_ + block_size_);
+  }
+  std::streamsize got = source_->sgetn(buf_.data() + end_, buf_.size() - end_);
+  if (got <= 0)
+  {
+    eof_ = true;
+    return false;
+  }
+  end_ += got;
+  return true;
+}
+
+bool abramov::RecordScanner::skipLine()
+{
+  while (true)
+  {
+    const void *found = std::memchr(buf_.data() + pos_, '\n', end_ - pos_);
+    if (found)
+    {
+      pos_ = static_cast< const char * >(found) - buf_.data() + 1;
+      return true;
+    }
+    pos_ = end_;
+    if (!refill())
+    {
+      return false;
+    }
+  }
+}
+
+abramov::RecordScanner::Status abramov::RecordScanner::atEnd() const noexcept
+{
+  return eof_ ? Status::FAIL : Status::MORE;
+}
+
+abramov::RecordScanner::Status abramov::RecordScanner::skipWs() noexcept
+{
+  while (cur_ < end_ && isSpace(buf_[cur_]))
+  {
+    ++cur_;
+  }
+  return cur_ < end_ ? Status::OK : atEnd();
+}
+
+abramov::RecordScanner::Status abramov::RecordScanner::delim(char expected) noexcept
+{
+  Status status = skipWs();
+  if (status != Status::OK)
+  {
+    return status;
+  }
+  return buf_[cur_++] == expected ? Status::OK : Status::FAIL;
+}
+
+abramov::RecordScanner::Status abramov::RecordScanner::key(size_t &number) noexcept
+{
+  Status status = skipWs();
+  if (status != Status::OK)
+  {
+    return status;
+  }
+  size_t begin = cur_;
+  while (cur_ < end_ && !isSpace(buf_[cur_]))
+  {
+    ++cur_;
+  }
+  if (cur_ == end_)
+  {
+    return atEnd();
+  }
+  const char *token = buf_.data() + begin;
+  if (cur_ - begin != 4 || std::memcmp(token, "key", 3) != 0 || token[3] < '1' || token[3] > '3')
+  {
+    return Status::FAIL;
+  }
+  number = token[3] - '0';
+  return Status::OK;
+}
+
+abramov::RecordScanner::Status abramov::RecordScanner::doubleLit(double &value)
+{
+  Status status = skipWs();
+  if (status != Status::OK)
+  {
+    return status;
+  }
+  number_.clear();
+  char c = buf_[cur_];
+  if (c == '+' || c == '-')
+  {
+    number_ += c;
+    if (++cur_ == end_)
+    {
+      return atEnd();
+    }
+    c = buf_[cur_];
+  }
+  bool found_mantissa = false;
+  while (c == '0')
+  {
+    if (!found_mantissa)
+    {
+      number_ += '0';
+      found_mantissa = true;
+    }
+    if (++cur_ == end_)
+    {
+      return atEnd();
+    }
+    c = buf_[cur_];
+  }
+  bool found_dec = false;
+  bool found_sci = false;
+  while (true)
+  {
+    if (isDigit(c))
+    {
+      number_ += c;
+      found_mantissa = true;
+    }
+    else if (c == '.' && !found_dec && !found_sci)
+    {
+      number_ += '.';
+      found_dec = true;
+    }
+    else if ((c == 'e' || c == 'E') && !found_sci && found_mantissa)
+    {
+      number_ += 'e';
+      found_sci = true;
+      if (++cur_ == end_)
+      {
+        return atEnd();
+      }
+      c = buf_[cur_];
+      if (c != '+' && c != '-')
+      {
+        continue;
+      }
+      number_ += c;
+    }
+    else
+    {
+      break;
+    }
+    if (++cur_ == end_)
+    {
+      return atEnd();
+    }
+    c = buf_[cur_];
+  }
+  if (fastDouble(number_, value))
+  {
+    return Status::OK;
+  }
+  char *parsed_end = nullptr;
+  value = std::strtod(number_.c_str(), &parsed_end);
+  if (parsed_end == number_.c_str() || *parsed_end != '\0')
+  {
+    return Status::FAIL;
+  }
+  if (value == std::numeric_limits< double >::infinity() || value == -std::numeric_limits< double >::infinity())
+  {
+    return Status::FAIL;
+  }
+  return Status::OK;
+}
+
+abramov::RecordScanner::Status abramov::RecordScanner::ullLit(unsigned long long &value) noexcept
+{
+  using ull = unsigned long long;
+  Status status = skipWs();
+  if (status != Status::OK)
+  {
+    return status;
+  }
+  char c = buf_[cur_];
+  bool negative = c == '-';
+  if (negative || c == '+')
+  {
+    if (++cur_ == end_)
+    {
+      return atEnd();
+    }
+    c = buf_[cur_];
+  }
+  bool found_zero = false;
+  while (c == '0')
+  {
+    found_zero = true;
+    if (++cur_ == end_)
+    {
+      return atEnd();
+    }
+    c = buf_[cur_];
+  }
+  constexpr ull max = std::numeric_limits< ull >::max();
+  constexpr ull smax = max / 10;
+  bool found_digit = false;
+  bool overflow = false;
+  ull result = 0;
+  while (isDigit(c))
+  {
+    ull digit = c - '0';
+    found_digit = true;
+    if (result > smax)
+    {
+      overflow = true;
+    }
+    else
+    {
+      result *= 10;
+      overflow |= result > max - digit;
+      result += digit;
+    }
+    if (++cur_ == end_)
+    {
+      return atEnd();
+    }
+    c = buf_[cur_];
+  }
+  if ((!found_digit && !found_zero) || overflow)
+  {
+    return Status::FAIL;
+  }
+  value = negative ? -result : result;
+  return Status::OK;
+}
+
+abramov::RecordScanner::Status abramov::RecordScanner::stringLit(size_t &begin, size_t &length) noexcept
+{
+  Status status = delim('"');
+  if (status != Status::OK)
+  {
+    return status;
+  }
+  const void *found = std::memchr(buf_.data() + cur_, '"', end_ - cur_);
+  if (!found)
+  {
+    cur_ = end_;
+    return atEnd();
+  }
+  size_t quote = static_cast< const char * >(found) - buf_.data();
+  begin = cur_;
+  length = quote - cur_;
+  cur_ = quote + 1;
+  return Status::OK;
+}
+
+abramov::RecordScanner::Status abramov::RecordScanner::record(DataStruct &data)
+{
+  cur_ = pos_;
+  Status status = delim('(');
+  status = status == Status::OK ? delim(':') : status;
+  double key1 = 0.0;
+  unsigned long long key2 = 0;
+  size_t key3_begin = 0;
+  size_t key3_length = 0;
+  constexpr size_t key_numbers = 3;
+  size_t count = 0;
+  while (count < key_numbers && status == Status::OK)
+  {
+    size_t number = 0;
+    status = key(number);
+    if (status != Status::OK)
+    {
+      break;
+    }
+    if (number == 1)
+    {
+      status = doubleLit(key1);
+      status = status == Status::OK ? delim('d') : status;
+    }
+    else if (number == 2)
+    {
+      status = ullLit(key2);
+      status = status == Status::OK ? delim('u') : status;
+      status = status == Status::OK ? delim('l') : status;
+      status = status == Status::OK ? delim('l') : status;
+    }
+    else
+    {
+      status = stringLit(key3_begin, key3_length);
+    }
+    status = status == Status::OK ? delim(':') : status;
+    ++count;
+  }
+  status = status == Status::OK ? delim(')') : status;
+  if (status == Status::OK)
+  {
+    data.key1 = key1;
+    data.key2 = key2;
+    data.key3.assign(buf_.data() + key3_begin, key3_length);
+  }
+  return status;
+}
@@ -0,0 +1,43 @@
+#ifndef RECORD_SCANNER_HPP
+#define RECORD_SCANNER_HPP
+#include <streambuf>
+#include <string>
+#include <vector>
+#include "datastruct.hpp"
+
+namespace abramov
+{
+  struct RecordScanner
+  {
+    explicit RecordScanner(std::streambuf *source, size_t block_size = 1 << 20);
+    bool next(DataStruct &data);
+  private:
+    enum class Status
+    {
+      OK,
+      FAIL,
+      MORE
+    };
+
+    std::streambuf *source_;
+    std::vector< char > buf_;
+    size_t block_size_;
+    size_t pos_;
+    size_t cur_;
+    size_t end_;
+    bool eof_;
+    std::string number_;
+
+    bool refill();
+    bool skipLine();
+    Status atEnd() const noexcept;
+    Status skipWs() noexcept;
+    Status delim(char expected) noexcept;
+    Status key(size_t &number) noexcept;
+    Status doubleLit(double &value);
+    Status ullLit(unsigned long long &value) noexcept;
+    Status stringLit(size_t &begin, size_t &length) noexcept;
+    Status record(DataStruct &data);
+  };
+}
+#endif
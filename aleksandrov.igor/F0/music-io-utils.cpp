@@ -31,6 +31,12 @@ namespace
   }
 }
 
+bool aleksandrov::isCorrectNote(const Note& note) noexcept
+{
+  bool accidental = note.accidental == '\0' || isCorrectAccidental(note.accidental);
+  return isCorrectLetter(note.letter) && accidental && isCorrectPitch(note.letter, note.pitch, note.accidental);
+}
+
 std::istream& aleksandrov::operator>>(std::istream& in, Note& note)
 {
   std::istream::sentry sentry(in);
@@ -38,7 +44,7 @@ std::istream& aleksandrov::operator>>(std::istream& in, Note& note)
   {
     return in;
   }
-  Note temp;
+  Note temp{ '\0', '\0', '\0' };
 
   char l = '\0';
   in >> l;
@@ -133,7 +139,7 @@ std::istream& aleksandrov::operator>>(std::istream& in, Chord& chord)
     {
       break;
     }
-    temp.notes.emplace(note, note.toSemitones());
+    temp.add(note);
   }
   while (in.peek() == '-' && in.get());
 
@@ -158,12 +164,12 @@ std::istream& aleksandrov::operator>>(std::istream& in, MusicalElement& element)
   {
     if (temp.notes.size() == 1)
     {
-      element = MusicalElement(temp.notes.begin()->first);
+      element = MusicalElement(temp.notes.front());
     }
     else if (temp.notes.size() == 2)
     {
-      Note first = temp.notes.begin()->first;
-      Note second = temp.notes.rbegin()->first;
+      Note first = temp.notes.front();
+      Note second = temp.notes.back();
       if (first.toString() > second.toString())
       {
         std::swap(first, second);
@@ -199,9 +205,8 @@ std::ostream& aleksandrov::operator<<(std::ostream& out, const Chord& chord)
   StreamGuard guard(out);
   const auto& notes = chord.notes;
   std::ostream_iterator< Note > outIt(out, "-");
-  KeyReturner< Note, size_t > returner;
-  std::transform(notes.begin(), std::prev(notes.end()), outIt, returner);
-  return out << notes.rbegin()->first;
+  std::copy(notes.begin(), std::prev(notes.end()), outIt);
+  return out << notes.back();
 }
 
 std::ostream& aleksandrov::operator<<(std::ostream& out, const MusicalElement& element)
@@ -6,6 +6,8 @@
 
 namespace aleksandrov
 {
+  bool isCorrectNote(const Note&) noexcept;
+
   std::istream& operator>>(std::istream&, Note&);
   std::istream& operator>>(std::istream&, Interval&);
   std::istream& operator>>(std::istream&, Chord&);
@@ -0,0 +1,391 @@
+#include "music-sequence.hpp"
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include "music-io-utils.hpp"
+
+namespace
+{
+  const char SEQUENCE_MAGIC[4] = { 'A', 'M', 'S', 'Q' };
+  constexpr unsigned char SEQUENCE_VERSION = 1;
+
+  struct NotesAdder
+  {
+    template< class Record >
+    size_t operator()(size_t sum, const Record& record) const noexcept
+    {
+      return sum + record.size;
+    }
+  };
+
+  void writeByte(std::ostream& out, unsigned char byte)
+  {
+    out.put(static_cast< char >(byte));
+  }
+
+  bool readByte(std::istream& in, unsigned char& byte)
+  {
+    char c = '\0';
+    if (!in.get(c))
+    {
+      return false;
+    }
+    byte = static_cast< unsigned char >(c);
+    return true;
+  }
+
+  void writeCount(std::ostream& out, std::uint32_t count)
+  {
+    for (size_t i = 0; i < 4; ++i)
+    {
+      writeByte(out, (count >> (8 * i)) & 0xFF);
+    }
+  }
+
+  bool readCount(std::istream& in, std::uint32_t& count)
+  {
+    count = 0;
+    for (size_t i = 0; i < 4; ++i)
+    {
+      unsigned char byte = 0;
+      if (!readByte(in, byte))
+      {
+        return false;
+      }
+      count |= static_cast< std::uint32_t >(byte) << (8 * i);
+    }
+    return true;
+  }
+
+  bool isCorrectCode(aleksandrov::NoteCode code) noexcept
+  {
+    return code < aleksandrov::NOTE_CODES && aleksandrov::isCorrectNote(aleksandrov::decodeNote(code));
+  }
+}
+
+aleksandrov::Sequence::Sequence():
+  records_(),
+  chordNotes_(),
+  unusedNotes_(0)
+{}
+
+size_t aleksandrov::Sequence::size() const noexcept
+{
+  return records_.size();
+}
+
+bool aleksandrov::Sequence::empty() const noexcept
+{
+  return records_.empty();
+}
+
+void aleksandrov::Sequence::clear() noexcept
+{
+  records_.clear();
+  chordNotes_.clear();
+  unusedNotes_ = 0;
+}
+
+aleksandrov::MusicalElement aleksandrov::Sequence::operator[](size_t pos) const
+{
+  assert(pos < size());
+  const Record& record = records_[pos];
+  switch (record.type)
+  {
+  case MusicalElementType::Note:
+    return MusicalElement(decodeNote(record.first));
+  case MusicalElementType::Interval:
+    return MusicalElement(Interval{ decodeNote(record.first), decodeNote(record.second) });
+  case MusicalElementType::Chord:
+    return MusicalElement(unpackChord(record));
+  default:
+    return MusicalElement();
+  }
+}
+
+aleksandrov::MusicalElementType aleksandrov::Sequence::typeAt(size_t pos) const
+{
+  assert(pos < size());
+  return records_[pos].type;
+}
+
+void aleksandrov::Sequence::push_back(const MusicalElement& element)
+{
+  records_.push_back(pack(element));
+}
+
+void aleksandrov::Sequence::pop_back()
+{
+  if (records_.empty())
+  {
+    throw std::logic_error("Sequence is empty!");
+  }
+  release(records_.back());
+  records_.pop_back();
+  compact();
+}
+
+void aleksandrov::Sequence::insert(size_t pos, const MusicalElement& element)
+{
+  assert(pos <= size());
+  Record record = pack(element);
+  records_.insert(records_.begin() + pos, record);
+}
+
+void aleksandrov::Sequence::erase(size_t pos)
+{
+  assert(pos < size());
+  release(records_[pos]);
+  records_.erase(records_.begin() + pos);
+  compact();
+}
+
+void aleksandrov::Sequence::append(const Sequence& other)
+{
+  size_t count = other.records_.size();
+  records_.reserve(records_.size() + count);
+  chordNotes_.reserve(chordNotes_.size() + other.chordNotes_.size() - other.unusedNotes_);
+  for (size_t i = 0; i < count; ++i)
+  {
+    const Record& record = other.records_[i];
+    if (record.type == MusicalElementType::Chord)
+    {
+      records_.push_back(packChord(other.chordNotes_.data() + record.offset, record.size));
+    }
+    else
+    {
+      records_.push_back(record);
+    }
+  }
+}
+
+size_t aleksandrov::Sequence::countNotes() const noexcept
+{
+  return std::accumulate(records_.begin(), records_.end(), size_t(0), NotesAdder{});
+}
+
+void aleksandrov::Sequence::inverseUp(size_t pos)
+{
+  assert(pos < size());
+  Record& record = records_[pos];
+  if (record.type == MusicalElementType::Note)
+  {
+    throw std::logic_error("Cannot inverse a note!");
+  }
+  else if (record.type == MusicalElementType::Interval)
+  {
+    Interval interval{ decodeNote(record.first), decodeNote(record.second) };
+    interval.inverseUp();
+    record.first = encodeNote(interval.first);
+    record.second = encodeNote(interval.second);
+  }
+  else if (record.type == MusicalElementType::Chord)
+  {
+    Chord chord = unpackChord(record);
+    chord.inverseUp();
+    repackChord(record, chord);
+  }
+}
+
+void aleksandrov::Sequence::inverseDown(size_t pos)
+{
+  assert(pos < size());
+  Record& record = records_[pos];
+  if (record.type == MusicalElementType::Note)
+  {
+    throw std::logic_error("Cannot inverse a note!");
+  }
+  else if (record.type == MusicalElementType::Interval)
+  {
+    Interval interval{ decodeNote(record.first), decodeNote(record.second) };
+    interval.inverseDown();
+    record.first = encodeNote(interval.first);
+    record.second = encodeNote(interval.second);
+  }
+  else if (record.type == MusicalElementType::Chord)
+  {
+    Chord chord = unpackChord(record);
+    chord.inverseDown();
+    repackChord(record, chord);
+  }
+}
+
+void aleksandrov::Sequence::save(std::ostream& out) const
+{
+  out.write(SEQUENCE_MAGIC, sizeof(SEQUENCE_MAGIC));
+  writeByte(out, SEQUENCE_VERSION);
+  writeCount(out, records_.size());
+  for (auto it = records_.begin(); it != records_.end(); ++it)
+  {
+    writeByte(out, static_cast< unsigned char >(it->type));
+    if (it->type == MusicalElementType::Chord)
+    {
+      writeByte(out, it->size);
+      const char* notes = reinterpret_cast< const char* >(chordNotes_.data() + it->offset);
+      out.write(notes, it->size);
+    }
+    else
+    {
+      writeByte(out, it->first);
+      if (it->type == MusicalElementType::Interval)
+      {
+        writeByte(out, it->second);
+      }
+    }
+  }
+}
+
+bool aleksandrov::Sequence::load(std::istream& in)
+{
+  char magic[sizeof(SEQUENCE_MAGIC)] = {};
+  unsigned char version = 0;
+  std::uint32_t count = 0;
+  in.read(magic, sizeof(magic));
+  if (!in || !std::equal(magic, magic + sizeof(magic), SEQUENCE_MAGIC))
+  {
+    return false;
+  }
+  if (!readByte(in, version) || version != SEQUENCE_VERSION || !readCount(in, count))
+  {
+    return false;
+  }
+  Sequence temp;
+  NoteCode notes[256] = {};
+  for (std::uint32_t i = 0; i < count; ++i)
+  {
+    unsigned char type = 0;
+    if (!readByte(in, type))
+    {
+      return false;
+    }
+    if (type == static_cast< unsigned char >(MusicalElementType::Chord))
+    {
+      unsigned char size = 0;
+      if (!readByte(in, size) || size == 0 || !in.read(reinterpret_cast< char* >(notes), size))
+      {
+        return false;
+      }
+      bool isSorted = std::all_of(notes, notes + size, isCorrectCode);
+      for (size_t j = 1; isSorted && j < size; ++j)
+      {
+        isSorted = codeSemitones(notes[j - 1]) < codeSemitones(notes[j]);
+      }
+      if (!isSorted)
+      {
+        return false;
+      }
+      temp.records_.push_back(temp.packChord(notes, size));
+    }
+    else if (type == static_cast< unsigned char >(MusicalElementType::Note))
+    {
+      NoteCode code = 0;
+      if (!readByte(in, code) || !isCorrectCode(code))
+      {
+        return false;
+      }
+      temp.records_.push_back(Record{ MusicalElementType::Note, 1, code, code, 0 });
+    }
+    else if (type == static_cast< unsigned char >(MusicalElementType::Interval))
+    {
+      NoteCode first = 0;
+      NoteCode second = 0;
+      if (!readByte(in, first) || !readByte(in, second) || !isCorrectCode(first) || !isCorrectCode(second))
+      {
+        return false;
+      }
+      temp.records_.push_back(Record{ MusicalElementType::Interval, 2, first, second, 0 });
+    }
+    else
+    {
+      return false;
+    }
+  }
+  *this = std::move(temp);
+  return true;
+}
+
+aleksandrov::Sequence::Record aleksandrov::Sequence::pack(const MusicalElement& element)
+{
+  switch (element.getType())
+  {
+  case MusicalElementType::Note:
+  {
+    NoteCode code = encodeNote(element.note());
+    return Record{ MusicalElementType::Note, 1, code, code, 0 };
+  }
+  case MusicalElementType::Interval:
+  {
+    const Interval& interval = element.interval();
+    return Record{ MusicalElementType::Interval, 2, encodeNote(interval.first), encodeNote(interval.second), 0 };
+  }
+  case MusicalElementType::Chord:
+  {
+    const std::vector< Note >& notes = element.chord().notes;
+    NoteCode codes[256] = {};
+    std::transform(notes.begin(), notes.end(), codes, encodeNote);
+    return packChord(codes, notes.size());
+  }
+  default:
+    return Record{ MusicalElementType::None, 0, 0, 0, 0 };
+  }
+}
+
+aleksandrov::Sequence::Record aleksandrov::Sequence::packChord(const NoteCode* notes, size_t size)
+{
+  assert(size < 256);
+  Record record{ MusicalElementType::Chord, static_cast< unsigned char >(size), 0, 0, 0 };
+  record.offset = chordNotes_.size();
+  chordNotes_.insert(chordNotes_.end(), notes, notes + size);
+  return record;
+}
+
+aleksandrov::Chord aleksandrov::Sequence::unpackChord(const Record& record) const
+{
+  Chord chord;
+  chord.notes.resize(record.size);
+  auto first = chordNotes_.begin() + record.offset;
+  std::transform(first, first + record.size, chord.notes.begin(), decodeNote);
+  return chord;
+}
+
+void aleksandrov::Sequence::repackChord(Record& record, const Chord& chord)
+{
+  assert(chord.notes.size() <= record.size);
+  auto first = chordNotes_.begin() + record.offset;
+  std::transform(chord.notes.begin(), chord.notes.end(), first, encodeNote);
+  unusedNotes_ += record.size - chord.notes.size();
+  record.size = chord.notes.size();
+}
+
+void aleksandrov::Sequence::release(const Record& record) noexcept
+{
+  if (record.type == MusicalElementType::Chord)
+  {
+    unusedNotes_ += record.size;
+  }
+}
+
+void aleksandrov::Sequence::compact()
+{
+  if (unusedNotes_ * 2 <= chordNotes_.size())
+  {
+    return;
+  }
+  std::vector< NoteCode > notes;
+  notes.reserve(chordNotes_.size() - unusedNotes_);
+  for (auto it = records_.begin(); it != records_.end(); ++it)
+  {
+    if (it->type == MusicalElementType::Chord)
+    {
+      auto first = chordNotes_.begin() + it->offset;
+      it->offset = notes.size();
+      notes.insert(notes.end(), first, first + it->size);
+    }
+  }
+  chordNotes_.swap(notes);
+  unusedNotes_ = 0;
+}
+
@@ -0,0 +1,64 @@
+#ifndef MUSIC_SEQUENCE_HPP
+#define MUSIC_SEQUENCE_HPP
+
+#include <cstdint>
+#include <ios>
+#include <vector>
+#include "music.hpp"
+
+namespace aleksandrov
+{
+  class Sequence;
+}
+
+class aleksandrov::Sequence
+{
+public:
+  using value_type = MusicalElement;
+
+  Sequence();
+
+  size_t size() const noexcept;
+  bool empty() const noexcept;
+  void clear() noexcept;
+
+  MusicalElement operator[](size_t) const;
+  MusicalElementType typeAt(size_t) const;
+
+  void push_back(const MusicalElement&);
+  void pop_back();
+  void insert(size_t, const MusicalElement&);
+  void erase(size_t);
+  void append(const Sequence&);
+
+  size_t countNotes() const noexcept;
+  void inverseUp(size_t);
+  void inverseDown(size_t);
+
+  void save(std::ostream&) const;
+  bool load(std::istream&);
+
+private:
+  struct Record
+  {
+    MusicalElementType type;
+    unsigned char size;
+    NoteCode first;
+    NoteCode second;
+    std::uint32_t offset;
+  };
+
+  std::vector< Record > records_;
+  std::vector< NoteCode > chordNotes_;
+  size_t unusedNotes_;
+
+  Record pack(const MusicalElement&);
+  Record packChord(const NoteCode*, size_t);
+  Chord unpackChord(const Record&) const;
+  void repackChord(Record&, const Chord&);
+  void release(const Record&) noexcept;
+  void compact();
+};
+
+#endif
+
@@ -1,21 +1,67 @@
 #include "music.hpp"
+#include <algorithm>
+#include <array>
 #include <stdexcept>
 #include <cassert>
 
 namespace
 {
-  const std::map< char, short > notesSemitones = {
-    { 'A', 0 },
-    { 'B', 1 },
-    { 'H', 2 },
-    { 'C', 3 },
-    { 'D', 5 },
-    { 'E', 7 },
-    { 'F', 8 },
-    { 'G', 10 }
+  constexpr size_t LETTERS = 8;
+  constexpr size_t ACCIDENTALS = 3;
+
+  const short letterSemitones[LETTERS] = { 0, 1, 3, 5, 7, 8, 10, 2 };
+  const char accidentals[ACCIDENTALS] = { '\0', '#', 'b' };
+
+  size_t accidentalIndex(char accidental) noexcept
+  {
+    return accidental == '#' ? 1 : (accidental == 'b' ? 2 : 0);
+  }
+
+  std::array< short, aleksandrov::NOTE_CODES > makeSemitonesTable() noexcept
+  {
+    std::array< short, aleksandrov::NOTE_CODES > table{};
+    for (size_t code = 0; code < table.size(); ++code)
+    {
+      size_t accidental = code % ACCIDENTALS;
+      size_t letter = code / ACCIDENTALS % LETTERS;
+      size_t pitch = code / ACCIDENTALS / LETTERS;
+      short shift = accidental == 1 ? 1 : (accidental == 2 ? -1 : 0);
+      table[code] = static_cast< short >(pitch * 12) + letterSemitones[letter] + shift;
+    }
+    return table;
+  }
+
+  const std::array< short, aleksandrov::NOTE_CODES > codesSemitones = makeSemitonesTable();
+
+  struct SemitonesLess
+  {
+    bool operator()(const aleksandrov::Note& lhs, short rhs) const
+    {
+      return lhs.toSemitones() < rhs;
+    }
   };
 }
 
+aleksandrov::NoteCode aleksandrov::encodeNote(const Note& note) noexcept
+{
+  size_t letter = note.letter - 'A';
+  size_t pitch = note.pitch - '0';
+  return (pitch * LETTERS + letter) * ACCIDENTALS + accidentalIndex(note.accidental);
+}
+
+aleksandrov::Note aleksandrov::decodeNote(NoteCode code) noexcept
+{
+  char accidental = accidentals[code % ACCIDENTALS];
+  char letter = 'A' + code / ACCIDENTALS % LETTERS;
+  char pitch = '0' + code / ACCIDENTALS / LETTERS;
+  return Note{ letter, accidental, pitch };
+}
+
+short aleksandrov::codeSemitones(NoteCode code) noexcept
+{
+  return codesSemitones[code];
+}
+
 std::string aleksandrov::Note::toString() const
 {
   std::string str;
@@ -30,16 +76,7 @@ std::string aleksandrov::Note::toString() const
 
 short aleksandrov::Note::toSemitones() const
 {
-  short semitones = notesSemitones.at(letter);
-  if (accidental == '#')
-  {
-    ++semitones;
-  }
-  else if (accidental == 'b')
-  {
-    --semitones;
-  }
-  return (pitch - '0') * 12 + semitones;
+  return codeSemitones(encodeNote(*this));
 }
 
 void aleksandrov::Interval::inverseUp()
@@ -73,21 +110,32 @@ void aleksandrov::Interval::inverseDown()
   std::swap(first, second);
 }
 
+bool aleksandrov::Chord::add(const Note& note)
+{
+  short semitones = note.toSemitones();
+  auto it = std::lower_bound(notes.begin(), notes.end(), semitones, SemitonesLess{});
+  if (it != notes.end() && it->toSemitones() == semitones)
+  {
+    return false;
+  }
+  notes.insert(it, note);
+  return true;
+}
+
 void aleksandrov::Chord::inverseUp()
 {
   if (notes.empty())
   {
     throw std::logic_error("Cannot inverse an empty chord!");
   }
-  Note lowest = notes.begin()->first;
-  Note inverted = lowest;
+  Note inverted = notes.front();
   ++inverted.pitch;
   if (inverted.pitch == '8' && inverted.letter != 'C')
   {
     throw std::logic_error("Inversing up lowest note is out of range!");
   }
   notes.erase(notes.begin());
-  notes.emplace(inverted, inverted.toSemitones());
+  add(inverted);
 }
 
 void aleksandrov::Chord::inverseDown()
@@ -96,8 +144,7 @@ void aleksandrov::Chord::inverseDown()
   {
     throw std::logic_error("Cannot inverse an empty chord!");
   }
-  Note highest = std::prev(notes.end())->first;
-  Note inverted = highest;
+  Note inverted = notes.back();
   --inverted.pitch;
   if (inverted.pitch == '0')
   {
@@ -110,80 +157,33 @@ void aleksandrov::Chord::inverseDown()
   {
     throw std::logic_error("Inversing down note is out of range!");
   }
-  notes.erase(std::prev(notes.end()));
-  notes.emplace(inverted, inverted.toSemitones());
+  notes.pop_back();
+  add(inverted);
 }
 
 aleksandrov::MusicalElement::MusicalElement():
-  type_(MusicalElementType::None)
+  type_(MusicalElementType::None),
+  interval_(),
+  chord_()
 {}
 
 aleksandrov::MusicalElement::MusicalElement(const Note& note):
   type_(MusicalElementType::Note),
-  note_(note)
+  interval_{ note, note },
+  chord_()
 {}
 
 aleksandrov::MusicalElement::MusicalElement(const Interval& interval):
   type_(MusicalElementType::Interval),
-  interval_(interval)
+  interval_(interval),
+  chord_()
 {}
 
 aleksandrov::MusicalElement::MusicalElement(const Chord& chord):
-  type_(MusicalElementType::Chord)
-{
-  new (std::addressof(chord_)) Chord(chord);
-}
-
-aleksandrov::MusicalElement::~MusicalElement() noexcept
-{
-  if (isChord())
-  {
-    chord_.~Chord();
-  }
-}
-
-aleksandrov::MusicalElement::MusicalElement(const MusicalElement& other):
-  type_(other.type_)
-{
-  switch (type_)
-  {
-  case MusicalElementType::Note:
-    note_ = other.note_;
-    break;
-  case MusicalElementType::Interval:
-    interval_ = other.interval_;
-    break;
-  case MusicalElementType::Chord:
-    new (std::addressof(chord_)) Chord(other.chord_);
-    break;
-  default:
-    break;
-  }
-}
-
-aleksandrov::MusicalElement& aleksandrov::MusicalElement::operator=(const MusicalElement& rhs)
-{
-  if (isChord())
-  {
-    chord_.~Chord();
-  }
-  switch (rhs.type_)
-  {
-  case MusicalElementType::Note:
-    note_ = rhs.note_;
-    break;
-  case MusicalElementType::Interval:
-    interval_ = rhs.interval_;
-    break;
-  case MusicalElementType::Chord:
-    new (std::addressof(chord_)) Chord(rhs.chord_);
-    break;
-  default:
-    break;
-  }
-  type_ = rhs.type_;
-  return *this;
-}
+  type_(MusicalElementType::Chord),
+  interval_(),
+  chord_(chord)
+{}
 
 aleksandrov::MusicalElementType aleksandrov::MusicalElement::getType() const noexcept
 {
@@ -199,7 +199,7 @@ aleksandrov::Note& aleksandrov::MusicalElement::note()
 const aleksandrov::Note& aleksandrov::MusicalElement::note() const
 {
   assert(isNote());
-  return note_;
+  return interval_.first;
 }
 
 aleksandrov::Interval& aleksandrov::MusicalElement::interval()
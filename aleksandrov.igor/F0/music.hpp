@@ -1,24 +1,29 @@
 #ifndef MUSIC_HPP
 #define MUSIC_HPP
 
-#include <map>
-#include <deque>
+#include <cstddef>
 #include <string>
+#include <vector>
 
 namespace aleksandrov
 {
   enum class NoteType;
-  enum class MusicalElementType;
+  enum class MusicalElementType: unsigned char;
 
   struct Note;
   struct Interval;
   struct Chord;
   class MusicalElement;
 
-  using Sequence = std::deque< MusicalElement >;
+  using NoteCode = unsigned char;
+  constexpr size_t NOTE_CODES = 216;
+
+  NoteCode encodeNote(const Note&) noexcept;
+  Note decodeNote(NoteCode) noexcept;
+  short codeSemitones(NoteCode) noexcept;
 }
 
-enum class aleksandrov::MusicalElementType
+enum class aleksandrov::MusicalElementType: unsigned char
 {
   Note,
   Interval,
@@ -47,15 +52,9 @@ struct aleksandrov::Interval
 
 struct aleksandrov::Chord
 {
-  struct NoteComparator
-  {
-    bool operator()(const Note& lhs, const Note& rhs) const
-    {
-      return lhs.toSemitones() < rhs.toSemitones();
-    }
-  };
-  std::map< Note, size_t, NoteComparator > notes;
+  std::vector< Note > notes;
 
+  bool add(const Note&);
   void inverseUp();
   void inverseDown();
 };
@@ -64,13 +63,9 @@ class aleksandrov::MusicalElement
 {
 public:
   MusicalElement();
-  MusicalElement(const MusicalElement&);
   explicit MusicalElement(const Note&);
   explicit MusicalElement(const Interval&);
   explicit MusicalElement(const Chord&);
-  ~MusicalElement() noexcept;
-
-  MusicalElement& operator=(const MusicalElement&);
 
   MusicalElementType getType() const noexcept;
 
@@ -91,12 +86,8 @@ public:
 
 private:
   MusicalElementType type_;
-  union
-  {
-    Note note_;
-    Interval interval_;
-    Chord chord_;
-  };
+  Interval interval_;
+  Chord chord_;
 };
 
 #endif
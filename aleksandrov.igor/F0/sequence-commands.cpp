@@ -5,34 +5,10 @@
 #include <iterator>
 #include <functional>
 #include <algorithm>
-#include <numeric>
-#include <vector>
 #include <map>
 #include <stream-guard.hpp>
 #include "music-io-utils.hpp"
 
-namespace
-{
-  using namespace aleksandrov;
-
-  size_t countNotes(const MusicalElement& element) noexcept
-  {
-    if (element.isNote())
-    {
-      return 1;
-    }
-    else if (element.isInterval())
-    {
-      return 2;
-    }
-    else if (element.isChord())
-    {
-      return element.chord().notes.size();
-    }
-    return 0;
-  }
-}
-
 void aleksandrov::processCommands(std::istream& in, std::ostream& out, Sequences& seqs)
 {
   std::map< std::string, std::function< void() > > commands;
@@ -104,12 +80,19 @@ void aleksandrov::loadSeq(std::istream& in, Sequences& seqs)
   std::string seqName;
   in >> fileName >> seqName;
 
-  std::ifstream file(fileName);
+  std::ifstream file(fileName, std::ios::binary);
   if (!file)
   {
     throw std::logic_error("Incorrect file!");
   }
   Sequence seq;
+  if (seq.load(file))
+  {
+    seqs[seqName] = std::move(seq);
+    return;
+  }
+  file.clear();
+  file.seekg(0);
   std::istream_iterator< MusicalElement > inItBegin(file);
   std::istream_iterator< MusicalElement > inItEnd;
   std::copy(inItBegin, inItEnd, std::back_inserter(seq));
@@ -134,15 +117,12 @@ void aleksandrov::saveSeq(std::istream& in, Sequences& seqs)
   }
   std::string fileName;
   in >> fileName;
-  std::ofstream file(fileName);
+  std::ofstream file(fileName, std::ios::binary);
   if (!file)
   {
     throw std::logic_error("Incorrect file!");
   }
-  const Sequence& sequence = seqIt->second;
-  std::ostream_iterator< MusicalElement > outIt(file, " ");
-  StreamGuard guard(file);
-  std::copy(sequence.begin(), sequence.end(), outIt);
+  seqIt->second.save(file);
   if (!file)
   {
     throw std::logic_error("Failed to write to file!");
@@ -217,7 +197,7 @@ void aleksandrov::addToSeq(std::istream& in, Sequences& seqs)
     {
       throw std::logic_error("Incorrect position!");
     }
-    sequence.insert(sequence.begin() + position, element);
+    sequence.insert(position, element);
   }
 }
 
@@ -242,7 +222,7 @@ void aleksandrov::removeFromSeq(std::istream& in, Sequences& seqs)
     {
       throw std::logic_error("Incorrect position!");
     }
-    sequence.erase(sequence.begin() + position - 1);
+    sequence.erase(position - 1);
   }
 }
 
@@ -270,8 +250,8 @@ void aleksandrov::mergeSeqs(std::istream& in, Sequences& seqs)
   const Sequence& seq1 = seqIt1->second;
   const Sequence& seq2 = seqIt2->second;
 
-  std::copy(seq1.begin(), seq1.end(), std::back_inserter(merged));
-  std::copy(seq2.begin(), seq2.end(), std::back_inserter(merged));
+  merged.append(seq1);
+  merged.append(seq2);
 
   seqs[newSeqName] = std::move(merged);
 }
@@ -286,9 +266,11 @@ void aleksandrov::printSeq(std::istream& in, std::ostream& out, const Sequences&
     throw std::logic_error("No such sequence '" + seqName + "'");
   }
   const Sequence& sequence = seqIt->second;
-  std::ostream_iterator< MusicalElement > outIt(out, "\n");
   StreamGuard guard(out);
-  std::copy(sequence.begin(), sequence.end(), outIt);
+  for (size_t i = 0; i < sequence.size(); ++i)
+  {
+    out << sequence[i] << '\n';
+  }
 }
 
 void aleksandrov::elementsSeq(std::istream& in, std::ostream& out, const Sequences& seqs)
@@ -313,10 +295,7 @@ void aleksandrov::notesSeq(std::istream& in, std::ostream& out, const Sequences&
   {
     throw std::logic_error("No such sequence '" + seqName + "'");
   }
-  const Sequence& sequence = seqIt->second;
-  std::vector< size_t > noteCounts(sequence.size());
-  std::transform(sequence.begin(), sequence.end(), noteCounts.begin(), countNotes);
-  size_t notesCount = std::accumulate(noteCounts.begin(), noteCounts.end(), 0);
+  size_t notesCount = seqIt->second.countNotes();
   out << "Total number of notes in '" << seqName << "': " << notesCount << '\n';
 }
 
@@ -336,7 +315,7 @@ void aleksandrov::typeSeq(std::istream& in, std::ostream& out, const Sequences&
     throw std::logic_error("Incorrect position!");
   }
   out << sequence[position - 1] << ": ";
-  switch (sequence[position - 1].getType())
+  switch (sequence.typeAt(position - 1))
   {
   case MusicalElementType::Note:
     out << "note";
@@ -368,7 +347,7 @@ void aleksandrov::inverseSeq(std::istream& in, Sequences& seqs)
   {
     throw std::logic_error("Incorrect position!");
   }
-  if (sequence[position - 1].isNote())
+  if (sequence.typeAt(position - 1) == MusicalElementType::Note)
   {
     throw std::logic_error("Cannot inverse a note!");
   }
@@ -376,11 +355,11 @@ void aleksandrov::inverseSeq(std::istream& in, Sequences& seqs)
   in >> direction;
   if (direction == "up")
   {
-    sequence[position - 1].inverseUp();
+    sequence.inverseUp(position - 1);
   }
   else if (direction == "down")
   {
-    sequence[position - 1].inverseDown();
+    sequence.inverseDown(position - 1);
   }
   else
   {
@@ -396,9 +375,9 @@ void aleksandrov::printHelp(std::ostream& out)
   out << "- create a new sequence with the name 'name'\n";
   out << "load <filename> <name>\n";
   out << "- load a new sequence with the name 'name' from the file 'filename'\n";
-  out << "  (make sure to type a full path to the file)\n";
+  out << "  (make sure to type a full path to the file; binary and text files are accepted)\n";
   out << "save <name> <filename>\n";
-  out << "- save a sequence with the name 'name' to the file 'filename'\n";
+  out << "- save a sequence with the name 'name' to the file 'filename' in binary form\n";
   out << "  (make sure to type a full path to the file)\n";
   out << "clear <name>\n";
   out << "- clear a sequence with the name 'name'\n";
@@ -3,7 +3,7 @@
 
 #include <ios>
 #include <unordered_map>
-#include "music.hpp"
+#include "music-sequence.hpp"
 
 namespace aleksandrov
 {
@@ -2,6 +2,7 @@
 #include <iostream>
 #include <stream-guard.hpp>
 #include <delimiter-io.hpp>
+#include <stream-cursor.hpp>
 
 std::istream& alymova::operator>>(std::istream& in, LabelIO&& object)
 {
@@ -10,16 +11,9 @@ std::istream& alymova::operator>>(std::istream& in, LabelIO&& object)
   {
     return in;
   }
-  char c;
-  for (size_t i = 0; i < object.exp.size(); i++)
-  {
-    in >> c;
-    if (c != object.exp[i])
-    {
-      in.setstate(std::ios::failbit);
-      break;
-    }
-  }
+  StreamCursor cursor(in);
+  for (size_t i = 0; i < object.exp.size() && cursor.expect(object.exp[i]); i++)
+  {}
   return in;
 }
 
@@ -42,7 +36,12 @@ std::istream& alymova::operator>>(std::istream& in, ChrLitIO&& object)
   {
     return in;
   }
-  return in >> DelimiterIO{'\''} >> object.c >> DelimiterIO{'\''};
+  StreamCursor cursor(in);
+  if (cursor.expect('\'') && cursor.ready() && cursor.get(object.c))
+  {
+    cursor.expect('\'');
+  }
+  return in;
 }
 
 std::istream& alymova::operator>>(std::istream& in, StringIO&& object)
@@ -55,9 +54,10 @@ std::istream& alymova::operator>>(std::istream& in, StringIO&& object)
   alymova::StreamGuard guard(in);
   in >> std::noskipws;
 
-  in >> DelimiterIO{'"'};
+  StreamCursor cursor(in);
+  cursor.expect('"');
   char next;
-  while (in >> next && next != '"')
+  while (cursor.ready() && cursor.get(next) && next != '"')
   {
     if (next == '\n')
     {
@@ -84,19 +84,25 @@ std::istream& alymova::operator>>(std::istream& in, DataStruct& object)
   in >> DelimiterIO{'('};
   while ((!flag1 || !flag2 || !flag3) && in)
   {
-    std::string name;
-    in >> name;
-    if (name == ":key1" && !flag1)
+    char key = 0;
+    in >> LiteralIO{":key"};
+    StreamCursor cursor(in);
+    if (!in || !cursor.getWordChar(key) || !cursor.atBoundary())
+    {
+      in.setstate(std::ios::failbit);
+      cursor.skipWord();
+    }
+    else if (key == '1' && !flag1)
     {
       flag1 = true;
       in >> UllOctIO{input.key1};
     }
-    else if (name == ":key2" && !flag2)
+    else if (key == '2' && !flag2)
     {
       flag2 = true;
       in >> ChrLitIO{input.key2};
     }
-    else if (name == ":key3" && !flag3)
+    else if (key == '3' && !flag3)
     {
       flag3 = true;
       in >> StringIO{input.key3};
@@ -1,16 +1,14 @@
 #include "delimiter-io.hpp"
+#include "stream-cursor.hpp"
 
 std::istream& alymova::operator>>(std::istream& in, DelimiterIO&& object)
 {
-  std::istream::sentry sentry(in);
-  if (!sentry)
-  {
-    return in;
-  }
-  char delim;
-  if ((in >> delim) && delim != object.exp)
-  {
-    in.setstate(std::ios::failbit);
-  }
+  StreamCursor(in).expect(object.exp);
+  return in;
+}
+
+std::istream& alymova::operator>>(std::istream& in, LiteralIO&& object)
+{
+  StreamCursor(in).expect(object.exp);
   return in;
 }
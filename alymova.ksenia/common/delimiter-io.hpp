@@ -9,7 +9,13 @@ namespace alymova
     char exp;
   };
 
+  struct LiteralIO
+  {
+    const char* exp;
+  };
+
   std::istream& operator>>(std::istream& in, DelimiterIO&& object);
+  std::istream& operator>>(std::istream& in, LiteralIO&& object);
 }
 
 #endif
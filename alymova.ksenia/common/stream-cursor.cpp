@@ -0,0 +1,147 @@
+#include "stream-cursor.hpp"
+
+namespace
+{
+  using traits = std::istream::traits_type;
+
+  int facetSlot()
+  {
+    static const int slot = std::ios_base::xalloc();
+    return slot;
+  }
+
+  void dropCachedFacet(std::ios_base::event event, std::ios_base& stream, int slot)
+  {
+    if (event != std::ios_base::erase_event)
+    {
+      stream.pword(slot) = nullptr;
+    }
+  }
+
+  const std::ctype< char >& cachedCtype(std::istream& in)
+  {
+    const int slot = facetSlot();
+    void*& cached = in.pword(slot);
+    if (!cached)
+    {
+      if (!in.iword(slot))
+      {
+        in.register_callback(dropCachedFacet, slot);
+        in.iword(slot) = 1;
+      }
+      const std::ctype< char >& facet = std::use_facet< std::ctype< char > >(in.getloc());
+      cached = const_cast< std::ctype< char >* >(&facet);
+    }
+    return *static_cast< const std::ctype< char >* >(cached);
+  }
+}
+
+alymova::StreamCursor::StreamCursor(std::istream& in):
+  in_(in),
+  buf_(in.rdbuf()),
+  ctype_(cachedCtype(in))
+{}
+
+bool alymova::StreamCursor::ready()
+{
+  if (!in_.good())
+  {
+    in_.setstate(std::ios::failbit);
+    return false;
+  }
+  return !(in_.flags() & std::ios::skipws) || skipws();
+}
+
+bool alymova::StreamCursor::skipws()
+{
+  traits::int_type c = buf_->sgetc();
+  while (!traits::eq_int_type(c, traits::eof()) && ctype_.is(std::ctype_base::space, traits::to_char_type(c)))
+  {
+    c = buf_->snextc();
+  }
+  if (traits::eq_int_type(c, traits::eof()))
+  {
+    in_.setstate(std::ios::eofbit | std::ios::failbit);
+    return false;
+  }
+  return true;
+}
+
+bool alymova::StreamCursor::get(char& c)
+{
+  traits::int_type next = buf_->sbumpc();
+  if (traits::eq_int_type(next, traits::eof()))
+  {
+    in_.setstate(std::ios::eofbit | std::ios::failbit);
+    return false;
+  }
+  c = traits::to_char_type(next);
+  return true;
+}
+
+bool alymova::StreamCursor::expect(char exp)
+{
+  char c = 0;
+  if (!ready() || !get(c))
+  {
+    return false;
+  }
+  if (c != exp)
+  {
+    in_.setstate(std::ios::failbit);
+    return false;
+  }
+  return true;
+}
+
+bool alymova::StreamCursor::expect(const char* exp)
+{
+  if (!ready())
+  {
+    return false;
+  }
+  for (; *exp != '\0'; exp++)
+  {
+    traits::int_type c = buf_->sgetc();
+    if (traits::eq_int_type(c, traits::eof()))
+    {
+      in_.setstate(std::ios::eofbit | std::ios::failbit);
+      return false;
+    }
+    if (!traits::eq_int_type(c, traits::to_int_type(*exp)))
+    {
+      in_.setstate(std::ios::failbit);
+      return false;
+    }
+    buf_->sbumpc();
+  }
+  return true;
+}
+
+bool alymova::StreamCursor::atBoundary()
+{
+  traits::int_type c = buf_->sgetc();
+  return traits::eq_int_type(c, traits::eof()) || ctype_.is(std::ctype_base::space, traits::to_char_type(c));
+}
+
+bool alymova::StreamCursor::getWordChar(char& c)
+{
+  if (atBoundary())
+  {
+    in_.setstate(traits::eq_int_type(buf_->sgetc(), traits::eof()) ? std::ios::eofbit | std::ios::failbit : std::ios::failbit);
+    return false;
+  }
+  return get(c);
+}
+
+void alymova::StreamCursor::skipWord()
+{
+  while (!atBoundary())
+  {
+    buf_->sbumpc();
+  }
+  if (traits::eq_int_type(buf_->sgetc(), traits::eof()))
+  {
+    in_.setstate(std::ios::eofbit);
+  }
+}
@@ -0,0 +1,26 @@
+#ifndef STREAM_CURSOR_HPP
+#define STREAM_CURSOR_HPP
+#include <iostream>
+#include <locale>
+
+namespace alymova
+{
+  class StreamCursor
+  {
+  public:
+    explicit StreamCursor(std::istream& in);
+    bool ready();
+    bool skipws();
+    bool get(char& c);
+    bool expect(char exp);
+    bool expect(const char* exp);
+    bool atBoundary();
+    bool getWordChar(char& c);
+    void skipWord();
+  private:
+    std::istream& in_;
+    std::streambuf* buf_;
+    const std::ctype< char >& ctype_;
+  };
+}
+#endif
@@ -59,6 +59,12 @@ bool averenkov::PolygonEqual::operator()(const Polygon& a, const Polygon& b) con
   return std::is_permutation(a.points.cbegin(), a.points.cend(), b.points.cbegin());
 }
 
+bool averenkov::EchoPredicate::operator()(const Polygon& kept, const Polygon& next) const
+{
+  PolygonEqual equal;
+  return next.hash == target.hash && kept.hash == target.hash && equal(next, target) && equal(kept, target);
+}
+
 bool averenkov::AreaComparator::operator()(const Polygon& a, const Polygon& b) const
 {
   return calculateArea(a) < calculateArea(b);
@@ -363,13 +369,8 @@ void averenkov::printRmEcho(std::istream& in, std::vector< Polygon >& polygons,
     throw std::runtime_error("Invalid RMECHO parameter");
   }
 
-  size_t removed = 0;
-  PolygonEqual comparator;
-  auto func = std::bind(&PolygonEqual::operator(), std::addressof(comparator), std::placeholders::_1, target);
-  auto newEnd = std::unique(polygons.begin(), polygons.end(), func);
-
-  removed = std::distance(newEnd, polygons.end());
+  auto newEnd = std::unique(polygons.begin(), polygons.end(), EchoPredicate{ target });
+  size_t removed = std::distance(newEnd, polygons.end());
   polygons.erase(newEnd, polygons.end());
   out << removed;
 }
-
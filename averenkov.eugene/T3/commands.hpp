@@ -161,6 +161,12 @@ namespace averenkov
     bool operator()(const Polygon& a, const Polygon& b) const;
   };
 
+  struct EchoPredicate
+  {
+    const Polygon& target;
+    bool operator()(const Polygon& kept, const Polygon& next) const;
+  };
+
   double calculateArea(const Polygon& poly);
   void printAreaSum(std::istream& in, const std::vector< Polygon >& polygons, std::ostream& out);
   void printMaxValueOf(std::istream& in, const std::vector< Polygon >& polygons, std::ostream& out);
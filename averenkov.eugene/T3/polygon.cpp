@@ -46,12 +46,21 @@ std::istream& averenkov::operator>>(std::istream& in, averenkov::Polygon& poly)
     in.setstate(std::ios::failbit);
     return in;
   }
-  poly.points = points;
+  poly.hash = hashPoints(points);
+  poly.points = std::move(points);
   return in;
 }
 
-bool averenkov::Polygon::operator==(const Polygon& other) const
+size_t averenkov::hashPoints(const std::vector< Point >& points)
 {
-  return points == other.points;
+  size_t hash = points.size();
+  for (auto it = points.cbegin(); it != points.cend(); ++it)
+  {
+    unsigned long long point = static_cast< unsigned long long >(static_cast< unsigned >(it->x)) << 32;
+    point |= static_cast< unsigned >(it->y);
+    point = (point ^ (point >> 33)) * 0xff51afd7ed558ccdULL;
+    point = (point ^ (point >> 33)) * 0xc4ceb9fe1a85ec53ULL;
+    hash += static_cast< size_t >(point ^ (point >> 33));
+  }
+  return hash;
 }
-
@@ -21,9 +21,11 @@ namespace averenkov
   struct Polygon
   {
     std::vector< Point > points;
-    bool operator==(const Polygon& other) const;
+    size_t hash = 0;
   };
 
+  size_t hashPoints(const std::vector< Point >& points);
+
   std::istream& operator>>(std::istream& in, Polygon& poly);
 
 };
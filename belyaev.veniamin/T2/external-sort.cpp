@@ -0,0 +1,268 @@
+#include "external-sort.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <stdlib.h>
+#include <unistd.h>
+
+namespace
+{
+  constexpr size_t MAX_FAN_IN = 64;
+
+  class RunReader
+  {
+    public:
+      RunReader(const std::string& path, size_t run):
+        file_(path, std::ios::binary),
+        run_(run),
+        current_()
+      {
+        if (!file_.is_open())
+        {
+          throw std::runtime_error("Cannot open run file " + path);
+        }
+      }
+
+      bool next()
+      {
+        return static_cast< bool >(belyaev::readBinary(file_, current_));
+      }
+
+      const belyaev::DataStruct& current() const
+      {
+        return current_;
+      }
+
+      belyaev::DataStruct& current()
+      {
+        return current_;
+      }
+
+      size_t run() const
+      {
+        return run_;
+      }
+
+    private:
+      std::ifstream file_;
+      size_t run_;
+      belyaev::DataStruct current_;
+  };
+
+  struct LaterRun
+  {
+    bool operator()(const RunReader* lhs, const RunReader* rhs) const
+    {
+      if (rhs->current() < lhs->current())
+      {
+        return true;
+      }
+      if (lhs->current() < rhs->current())
+      {
+        return false;
+      }
+      return lhs->run() > rhs->run();
+    }
+  };
+
+  struct TextSink
+  {
+    std::ostream& out;
+    void operator()(const belyaev::DataStruct& src) const
+    {
+      out << src << '\n';
+    }
+  };
+
+  struct BinarySink
+  {
+    std::ostream& out;
+    void operator()(const belyaev::DataStruct& src) const
+    {
+      belyaev::writeBinary(out, src);
+    }
+  };
+
+  std::string createRun(const belyaev::ExternalSortConfig& config)
+  {
+    std::string path = config.tempDir + "/belyaev-t2-run-XXXXXX";
+    int fd = mkstemp(&path[0]);
+    if (fd == -1)
+    {
+      throw std::runtime_error("Cannot create run file in " + config.tempDir);
+    }
+    close(fd);
+    return path;
+  }
+
+  std::ofstream openRun(const std::string& path)
+  {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+      throw std::runtime_error("Cannot create run file " + path);
+    }
+    return file;
+  }
+
+  template< class Sink >
+  void mergeRuns(const std::vector< std::string >& paths, size_t first, size_t last, Sink sink)
+  {
+    std::vector< std::unique_ptr< RunReader > > readers;
+    std::priority_queue< RunReader*, std::vector< RunReader* >, LaterRun > heap;
+    for (size_t i = first; i < last; ++i)
+    {
+      readers.emplace_back(new RunReader(paths[i], i));
+      if (readers.back()->next())
+      {
+        heap.push(readers.back().get());
+      }
+    }
+    while (!heap.empty())
+    {
+      RunReader* top = heap.top();
+      heap.pop();
+      sink(top->current());
+      if (top->next())
+      {
+        heap.push(top);
+      }
+    }
+  }
+
+  void removeRuns(const std::vector< std::string >& paths)
+  {
+    for (auto it = paths.cbegin(); it != paths.cend(); ++it)
+    {
+      std::remove(it->c_str());
+    }
+  }
+
+  template< class T >
+  std::ostream& writeRaw(std::ostream& out, const T& value)
+  {
+    return out.write(reinterpret_cast< const char* >(std::addressof(value)), sizeof(value));
+  }
+
+  template< class T >
+  std::istream& readRaw(std::istream& in, T& value)
+  {
+    return in.read(reinterpret_cast< char* >(std::addressof(value)), sizeof(value));
+  }
+}
+
+bool belyaev::readRun(std::istream& in, std::vector< DataStruct >& run, size_t limit)
+{
+  while (run.size() < limit && !in.eof() && !in.bad())
+  {
+    if (in.fail())
+    {
+      in.clear();
+      in.ignore(std::numeric_limits< std::streamsize >::max(), '\n');
+    }
+    DataStruct next;
+    if (in >> next)
+    {
+      run.push_back(std::move(next));
+    }
+  }
+  return !in.bad();
+}
+
+std::ostream& belyaev::writeBinary(std::ostream& out, const DataStruct& src)
+{
+  std::uint64_t length = src.key3.size();
+  writeRaw(out, src.key1);
+  writeRaw(out, src.key2.first);
+  writeRaw(out, src.key2.second);
+  writeRaw(out, length);
+  return out.write(src.key3.data(), src.key3.size());
+}
+
+std::istream& belyaev::readBinary(std::istream& in, DataStruct& dst)
+{
+  DataStruct tmp;
+  std::uint64_t length = 0;
+  readRaw(in, tmp.key1);
+  readRaw(in, tmp.key2.first);
+  readRaw(in, tmp.key2.second);
+  if (!readRaw(in, length))
+  {
+    return in;
+  }
+  tmp.key3.resize(length);
+  if (in.read(&tmp.key3[0], length))
+  {
+    dst = std::move(tmp);
+  }
+  return in;
+}
+
+void belyaev::externalSort(std::istream& in, std::ostream& out, const ExternalSortConfig& config)
+{
+  if (config.runSize == 0)
+  {
+    throw std::invalid_argument("Run size must be positive");
+  }
+
+  std::vector< std::string > paths;
+  std::vector< std::string > merged;
+  try
+  {
+    std::vector< DataStruct > run;
+    run.reserve(config.runSize);
+    while (!in.eof())
+    {
+      if (!readRun(in, run, config.runSize))
+      {
+        throw std::runtime_error("Input error.");
+      }
+      if (run.empty())
+      {
+        continue;
+      }
+      std::stable_sort(run.begin(), run.end());
+      paths.push_back(createRun(config));
+      std::ofstream file = openRun(paths.back());
+      std::for_each(run.cbegin(), run.cend(), BinarySink{file});
+      if (!file.flush())
+      {
+        throw std::runtime_error("Cannot write run file " + paths.back());
+      }
+      run.clear();
+    }
+
+    while (paths.size() > MAX_FAN_IN)
+    {
+      for (size_t first = 0; first < paths.size(); first += MAX_FAN_IN)
+      {
+        size_t last = std::min(first + MAX_FAN_IN, paths.size());
+        merged.push_back(createRun(config));
+        std::ofstream file = openRun(merged.back());
+        mergeRuns(paths, first, last, BinarySink{file});
+        if (!file.flush())
+        {
+          throw std::runtime_error("Cannot write run file " + merged.back());
+        }
+      }
+      removeRuns(paths);
+      paths.swap(merged);
+      merged.clear();
+    }
+
+    mergeRuns(paths, 0, paths.size(), TextSink{out});
+  }
+  catch (...)
+  {
+    removeRuns(paths);
+    removeRuns(merged);
+    throw;
+  }
+  removeRuns(paths);
+}
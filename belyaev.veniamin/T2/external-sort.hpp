@@ -0,0 +1,22 @@
+#ifndef EXTERNAL_SORT_HPP
+#define EXTERNAL_SORT_HPP
+#include <iostream>
+#include <string>
+#include <vector>
+#include "data-struct.hpp"
+
+namespace belyaev
+{
+  struct ExternalSortConfig
+  {
+    size_t runSize;
+    std::string tempDir;
+  };
+
+  bool readRun(std::istream& in, std::vector< DataStruct >& run, size_t limit);
+  std::ostream& writeBinary(std::ostream& out, const DataStruct& src);
+  std::istream& readBinary(std::istream& in, DataStruct& dst);
+  void externalSort(std::istream& in, std::ostream& out, const ExternalSortConfig& config);
+}
+
+#endif
@@ -1,15 +1,70 @@
 #include <vector>
 #include <iterator>
 #include <algorithm>
+#include <cstdlib>
 #include <limits>
+#include <stdexcept>
+#include <string>
 #include "data-struct.hpp"
+#include "external-sort.hpp"
 
-int main()
+namespace
+{
+  bool parseConfig(int argc, char* argv[], belyaev::ExternalSortConfig& config)
+  {
+    const char* tmp = std::getenv("TMPDIR");
+    config.runSize = 0;
+    config.tempDir = (tmp && *tmp) ? tmp : ".";
+    for (int i = 1; i < argc; i += 2)
+    {
+      std::string option = argv[i];
+      if (i + 1 >= argc)
+      {
+        return false;
+      }
+      if (option == "--run-size")
+      {
+        config.runSize = std::stoull(argv[i + 1]);
+      }
+      else if (option == "--temp-dir")
+      {
+        config.tempDir = argv[i + 1];
+      }
+      else
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+}
+
+int main(int argc, char* argv[])
 {
   using namespace belyaev;
   using istreamDS = std::istream_iterator< DataStruct >;
   using ostreamDS = std::ostream_iterator< DataStruct >;
 
+  ExternalSortConfig config;
+  try
+  {
+    if (!parseConfig(argc, argv, config))
+    {
+      std::cerr << "Usage: " << argv[0] << " [--run-size <records>] [--temp-dir <path>]\n";
+      return 1;
+    }
+    if (config.runSize != 0)
+    {
+      externalSort(std::cin, std::cout, config);
+      return 0;
+    }
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << e.what() << '\n';
+    return 2;
+  }
+
   std::vector< DataStruct > data;
   while (!std::cin.eof() && !std::cin.bad())
   {
@@ -27,7 +82,7 @@ int main()
     return 2;
   }
 
-  std::sort(data.begin(), data.end());
+  std::stable_sort(data.begin(), data.end());
   std::copy(data.begin(), data.end(), ostreamDS{std::cout, "\n"});
 
   return 0;
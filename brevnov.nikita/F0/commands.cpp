@@ -38,6 +38,21 @@ namespace
     const std::string& name;
   };
 
+  template < class Container >
+  void addUnique(Container& target, const std::string& playerName, const brevnov::Player& player)
+  {
+    PlayerNameComparator comp{playerName};
+    bool exists = std::find_if(target.begin(), target.end(), comp) != target.end();
+    if (!exists)
+    {
+      target.emplace(playerName, player);
+    }
+    else
+    {
+      std::cerr << "Player already exist!\n";
+    }
+  }
+
   void addPlayer(std::istream& in, brevnov::League& league, std::string teamName)
   {
     std::string playerName, position;
@@ -48,16 +63,13 @@ namespace
       size_t raiting = rait;
       size_t price = pr;
       auto teamIt = league.teams_.find(teamName);
-      auto& targetMap = (teamIt != league.teams_.end()) ? teamIt->second.players_ : league.fa_;
-      PlayerNameComparator comp{playerName};
-      bool exists = std::find_if(targetMap.begin(), targetMap.end(), comp) != targetMap.end();
-      if (!exists)
+      if (teamIt != league.teams_.end())
       {
-        targetMap.emplace(playerName, brevnov::Player(position, raiting, price));
+        addUnique(teamIt->second.players_, playerName, brevnov::Player(position, raiting, price));
       }
       else
       {
-        std::cerr << "Player already exist!\n";
+        addUnique(league.fa_, playerName, brevnov::Player(position, raiting, price));
       }
     }
     else
@@ -377,17 +389,26 @@ namespace
     brevnov::League& league;
   };
 
-  struct PositionBuyer
+  struct LineupBuyer
   {
     bool operator()(brevnov::Position pos) const
     {
-      buyP(out, league, team, budget, pos);
+      auto playerIt = lineup[static_cast< size_t >(pos)];
+      if (playerIt == league.fa_.end())
+      {
+        out << "Player not found!\n";
+        return false;
+      }
+      team.budget_ -= playerIt->second.price_;
+      out << "Bought " << playerIt->first << " " << playerIt->second << "\n";
+      team.players_.insert(*playerIt);
+      league.fa_.erase(playerIt);
       return true;
     }
     std::ostream& out;
     brevnov::League& league;
     brevnov::Team& team;
-    size_t budget;
+    const brevnov::FreeAgents::Lineup& lineup;
   };
 
   struct TeamPlayerPositionPrinter
@@ -514,10 +535,8 @@ void brevnov::updateRating(std::istream& in, League& league)
       return;
     }
   }
-  auto faIt = league.fa_.find(playerName);
-  if (faIt != league.fa_.end())
+  if (league.fa_.setRating(playerName, raiting))
   {
-    faIt->second.raiting_ = raiting;
     return;
   }
   std::cerr << "Player not found!\n";
@@ -618,7 +637,8 @@ void brevnov::buyTeam(std::istream& in, std::ostream& out, League& league)
   }
   const std::array<Position, 6> positions = {Position::LF, Position::RF,
     Position::CF,Position::LB, Position::RB, Position::G};
-  PositionBuyer buyer{out, league, teamIt->second, bud / 6};
+  FreeAgents::Lineup lineup = league.fa_.bestLineup(bud);
+  LineupBuyer buyer{out, league, teamIt->second, lineup};
   std::vector<int> dummy(positions.size());
   std::transform(positions.begin(), positions.end(), dummy.begin(), buyer);
 }
@@ -0,0 +1,317 @@
+#include "hockey.hpp"
+#include <algorithm>
+
+namespace
+{
+  template < class T >
+  struct PriceThenRaiting
+  {
+    bool operator()(const T& a, const T& b) const
+    {
+      if (a.price != b.price)
+      {
+        return a.price < b.price;
+      }
+      return a.raiting > b.raiting;
+    }
+  };
+
+  template < class T >
+  void dropDominated(std::vector< T >& options)
+  {
+    std::stable_sort(options.begin(), options.end(), PriceThenRaiting< T >{});
+    size_t kept = 0;
+    for (size_t i = 0; i < options.size(); ++i)
+    {
+      if (kept == 0 || options[i].raiting > options[kept - 1].raiting)
+      {
+        options[kept++] = options[i];
+      }
+    }
+    options.resize(kept);
+  }
+
+  template < class T >
+  struct PriceLess
+  {
+    bool operator()(const T& option, size_t price) const
+    {
+      return option.price < price;
+    }
+
+    bool operator()(size_t price, const T& option) const
+    {
+      return price < option.price;
+    }
+  };
+
+  size_t positionIndex(brevnov::Position pos)
+  {
+    return static_cast< size_t >(pos);
+  }
+}
+
+bool brevnov::FreeAgents::PriceOrder::operator()(const_iterator a, const_iterator b) const
+{
+  if (a->second.price_ != b->second.price_)
+  {
+    return a->second.price_ < b->second.price_;
+  }
+  if (a->second.raiting_ != b->second.raiting_)
+  {
+    return a->second.raiting_ > b->second.raiting_;
+  }
+  return a->first < b->first;
+}
+
+brevnov::FreeAgents::FreeAgents():
+  players_(),
+  byPosition_(),
+  frontiers_(),
+  halves_(),
+  halfBudget_()
+{
+  dirty_.fill(true);
+  halfDirty_.fill(true);
+}
+
+brevnov::FreeAgents::FreeAgents(const FreeAgents& other):
+  FreeAgents()
+{
+  players_ = other.players_;
+  for (auto it = players_.cbegin(); it != players_.cend(); ++it)
+  {
+    link(it);
+  }
+}
+
+brevnov::FreeAgents& brevnov::FreeAgents::operator=(const FreeAgents& other)
+{
+  if (this != &other)
+  {
+    FreeAgents copy(other);
+    players_.swap(copy.players_);
+    byPosition_.swap(copy.byPosition_);
+    dirty_.fill(true);
+    halfDirty_.fill(true);
+  }
+  return *this;
+}
+
+brevnov::FreeAgents::const_iterator brevnov::FreeAgents::begin() const
+{
+  return players_.begin();
+}
+
+brevnov::FreeAgents::const_iterator brevnov::FreeAgents::end() const
+{
+  return players_.end();
+}
+
+brevnov::FreeAgents::const_iterator brevnov::FreeAgents::find(const std::string& name) const
+{
+  return players_.find(name);
+}
+
+size_t brevnov::FreeAgents::size() const
+{
+  return players_.size();
+}
+
+bool brevnov::FreeAgents::empty() const
+{
+  return players_.empty();
+}
+
+std::pair< brevnov::FreeAgents::const_iterator, bool > brevnov::FreeAgents::insert(const value_type& player)
+{
+  auto result = players_.insert(player);
+  if (result.second)
+  {
+    link(result.first);
+  }
+  return result;
+}
+
+brevnov::FreeAgents::const_iterator brevnov::FreeAgents::insert(const_iterator hint, const value_type& player)
+{
+  size_t before = players_.size();
+  auto it = players_.insert(hint, player);
+  if (players_.size() != before)
+  {
+    link(it);
+  }
+  return it;
+}
+
+std::pair< brevnov::FreeAgents::const_iterator, bool > brevnov::FreeAgents::emplace(const std::string& name,
+  const Player& player)
+{
+  return insert(value_type(name, player));
+}
+
+brevnov::FreeAgents::const_iterator brevnov::FreeAgents::erase(const_iterator pos)
+{
+  unlink(pos);
+  return players_.erase(pos);
+}
+
+size_t brevnov::FreeAgents::erase(const std::string& name)
+{
+  auto it = players_.find(name);
+  if (it == players_.end())
+  {
+    return 0;
+  }
+  erase(it);
+  return 1;
+}
+
+bool brevnov::FreeAgents::setRating(const std::string& name, size_t raiting)
+{
+  auto it = players_.find(name);
+  if (it == players_.end())
+  {
+    return false;
+  }
+  unlink(it);
+  it->second.raiting_ = raiting;
+  link(it);
+  return true;
+}
+
+brevnov::FreeAgents::Lineup brevnov::FreeAgents::bestLineup(size_t budget) const
+{
+  const std::vector< Combination >& forwards = half(0, budget);
+  const std::vector< Combination >& backs = half(1, budget);
+  const Combination* bestForwards = &forwards.front();
+  const Combination* bestBacks = &backs.front();
+  size_t bestRaiting = 0;
+  size_t bestPrice = 0;
+  size_t affordable = backs.size();
+  for (auto it = forwards.begin(); it != forwards.end() && it->price <= budget; ++it)
+  {
+    size_t rest = budget - it->price;
+    while (backs[affordable - 1].price > rest)
+    {
+      --affordable;
+    }
+    const Combination& backLine = backs[affordable - 1];
+    size_t raiting = it->raiting + backLine.raiting;
+    size_t price = it->price + backLine.price;
+    if (raiting > bestRaiting || (raiting == bestRaiting && price < bestPrice))
+    {
+      bestForwards = &*it;
+      bestBacks = &backLine;
+      bestRaiting = raiting;
+      bestPrice = price;
+    }
+  }
+  Lineup lineup;
+  std::copy(bestForwards->picks.begin(), bestForwards->picks.end(), lineup.begin());
+  std::copy(bestBacks->picks.begin(), bestBacks->picks.end(), lineup.begin() + POSITION_COUNT / 2);
+  return lineup;
+}
+
+void brevnov::FreeAgents::link(const_iterator player)
+{
+  size_t pos = positionIndex(player->second.position_);
+  byPosition_[pos].insert(player);
+  if (dirty_[pos])
+  {
+    return;
+  }
+  const std::vector< Choice >& choices = frontiers_[pos];
+  const Player& added = player->second;
+  auto next = std::upper_bound(choices.begin(), choices.end(), added.price_, PriceLess< Choice >{});
+  const Choice& cheaper = *(next - 1);
+  bool dominated = cheaper.raiting > added.raiting_;
+  if (cheaper.raiting == added.raiting_)
+  {
+    dominated = cheaper.price < added.price_ || cheaper.player == players_.end();
+    dominated = dominated || cheaper.player->first < player->first;
+  }
+  if (!dominated)
+  {
+    markDirty(pos);
+  }
+}
+
+void brevnov::FreeAgents::unlink(const_iterator player)
+{
+  size_t pos = positionIndex(player->second.position_);
+  byPosition_[pos].erase(player);
+  if (dirty_[pos])
+  {
+    return;
+  }
+  const std::vector< Choice >& choices = frontiers_[pos];
+  auto it = std::lower_bound(choices.begin() + 1, choices.end(), player->second.price_, PriceLess< Choice >{});
+  if (it != choices.end() && it->player == player)
+  {
+    markDirty(pos);
+  }
+}
+
+void brevnov::FreeAgents::markDirty(size_t pos) const
+{
+  dirty_[pos] = true;
+  halfDirty_[pos / (POSITION_COUNT / 2)] = true;
+}
+
+const std::vector< brevnov::FreeAgents::Choice >& brevnov::FreeAgents::frontier(size_t pos) const
+{
+  std::vector< Choice >& choices = frontiers_[pos];
+  if (!dirty_[pos])
+  {
+    return choices;
+  }
+  choices.clear();
+  choices.push_back(Choice{0, 0, players_.end()});
+  for (auto it = byPosition_[pos].begin(); it != byPosition_[pos].end(); ++it)
+  {
+    const Player& player = (*it)->second;
+    if (player.raiting_ > choices.back().raiting)
+    {
+      choices.push_back(Choice{player.price_, player.raiting_, *it});
+    }
+  }
+  dirty_[pos] = false;
+  return choices;
+}
+
+const std::vector< brevnov::FreeAgents::Combination >& brevnov::FreeAgents::half(size_t index, size_t budget) const
+{
+  std::vector< Combination >& result = halves_[index];
+  if (!halfDirty_[index] && budget <= halfBudget_[index])
+  {
+    return result;
+  }
+  constexpr size_t width = POSITION_COUNT / 2;
+  Combination empty{0, 0, {}};
+  empty.picks.fill(players_.end());
+  std::vector< Combination > current(1, empty);
+  for (size_t k = 0; k < width; ++k)
+  {
+    const std::vector< Choice >& choices = frontier(index * width + k);
+    std::vector< Combination > next;
+    next.reserve(current.size() * choices.size());
+    for (auto it = current.begin(); it != current.end(); ++it)
+    {
+      for (auto choice = choices.begin(); choice != choices.end() && it->price + choice->price <= budget; ++choice)
+      {
+        Combination combined = *it;
+        combined.price += choice->price;
+        combined.raiting += choice->raiting;
+        combined.picks[k] = choice->player;
+        next.push_back(combined);
+      }
+    }
+    dropDominated(next);
+    current.swap(next);
+  }
+  result.swap(current);
+  halfDirty_[index] = false;
+  halfBudget_[index] = budget;
+  return result;
+}
@@ -3,6 +3,9 @@
 #include <string>
 #include <iostream>
 #include <map>
+#include <set>
+#include <array>
+#include <vector>
 namespace brevnov
 {
   enum class Position
@@ -58,6 +61,69 @@ namespace brevnov
     size_t price_;
   };
 
+  constexpr size_t POSITION_COUNT = 6;
+
+  class FreeAgents
+  {
+  public:
+    using container_type = std::map< std::string, Player >;
+    using value_type = container_type::value_type;
+    using const_iterator = container_type::const_iterator;
+    using iterator = const_iterator;
+    using Lineup = std::array< const_iterator, POSITION_COUNT >;
+
+    FreeAgents();
+    FreeAgents(const FreeAgents& other);
+    FreeAgents& operator=(const FreeAgents& other);
+
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator find(const std::string& name) const;
+    size_t size() const;
+    bool empty() const;
+
+    std::pair< const_iterator, bool > insert(const value_type& player);
+    const_iterator insert(const_iterator hint, const value_type& player);
+    std::pair< const_iterator, bool > emplace(const std::string& name, const Player& player);
+    const_iterator erase(const_iterator pos);
+    size_t erase(const std::string& name);
+    bool setRating(const std::string& name, size_t raiting);
+
+    Lineup bestLineup(size_t budget) const;
+
+  private:
+    struct PriceOrder
+    {
+      bool operator()(const_iterator a, const_iterator b) const;
+    };
+    struct Choice
+    {
+      size_t price;
+      size_t raiting;
+      const_iterator player;
+    };
+    struct Combination
+    {
+      size_t price;
+      size_t raiting;
+      std::array< const_iterator, POSITION_COUNT / 2 > picks;
+    };
+
+    container_type players_;
+    std::array< std::set< const_iterator, PriceOrder >, POSITION_COUNT > byPosition_;
+    mutable std::array< std::vector< Choice >, POSITION_COUNT > frontiers_;
+    mutable std::array< std::vector< Combination >, 2 > halves_;
+    mutable std::array< bool, POSITION_COUNT > dirty_;
+    mutable std::array< bool, 2 > halfDirty_;
+    mutable std::array< size_t, 2 > halfBudget_;
+
+    void link(const_iterator player);
+    void unlink(const_iterator player);
+    void markDirty(size_t pos) const;
+    const std::vector< Choice >& frontier(size_t pos) const;
+    const std::vector< Combination >& half(size_t index, size_t budget) const;
+  };
+
   struct Team
   {
     Team(size_t budget):
@@ -70,7 +136,7 @@ namespace brevnov
 
   struct League
   {
-    std::map< std::string, Player > fa_;
+    FreeAgents fa_;
     std::map< std::string, Team > teams_;
   };
 
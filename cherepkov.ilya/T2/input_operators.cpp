@@ -1,4 +1,69 @@
 #include "input_operators.hpp"
+#include <cstdint>
+
+namespace
+{
+  constexpr size_t BLOCK = 8;
+  constexpr uint64_t ZEROS = 0x3030303030303030ULL;
+  constexpr uint64_t LOW_BITS = 0x0101010101010101ULL;
+  constexpr uint64_t GATHER = 0x8040201008040201ULL;
+
+  uint64_t loadBlock(const char* block)
+  {
+    uint64_t word = 0;
+    for (size_t i = BLOCK; i > 0; --i)
+    {
+      word = (word << 8) | static_cast< unsigned char >(block[i - 1]);
+    }
+    return word;
+  }
+
+  size_t leadingBinaryDigits(const char* block, size_t size)
+  {
+    size_t count = 0;
+    while (count < size && (block[count] == '0' || block[count] == '1'))
+    {
+      ++count;
+    }
+    return count;
+  }
+
+  // Takes runs of '0'/'1' that are already in the get area, eight digits per step:
+  // after subtracting '0' from every byte a block of digits has no bits outside
+  // the lowest bit of each byte, and one multiply gathers those bits, first digit
+  // highest, into the top byte. The first other character is put back; returns
+  // false if the buffer refused it
+  bool readBinaryBlocks(std::streambuf& buf, unsigned long long& number, char& last)
+  {
+    char block[BLOCK] = {};
+    while (buf.in_avail() >= static_cast< std::streamsize >(BLOCK))
+    {
+      size_t size = buf.sgetn(block, BLOCK);
+      uint64_t bits = loadBlock(block) - ZEROS;
+      if (size == BLOCK && (bits & ~LOW_BITS) == 0)
+      {
+        number = (number << BLOCK) | ((bits * GATHER) >> 56);
+        last = block[BLOCK - 1];
+        continue;
+      }
+      size_t digits = leadingBinaryDigits(block, size);
+      for (size_t i = 0; i < digits; ++i)
+      {
+        number = (number << 1) + (block[i] - '0');
+        last = block[i];
+      }
+      for (size_t i = size; i > digits; --i)
+      {
+        if (std::istream::traits_type::eq_int_type(buf.sputbackc(block[i - 1]), std::istream::traits_type::eof()))
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+    return true;
+  }
+}
 
 std::istream& cherepkov::operator>>(std::istream& in, UllLitValue&& dest)
 {
@@ -20,8 +85,17 @@ std::istream& cherepkov::operator>>(std::istream& in, UllBinValue&& dest)
   char c = 0;
   unsigned long long number = 0;
   in >> DelimiterIO { '0' } >> DelimiterIO { 'b' };
-  while (in >> c)
+  while (in)
   {
+    if (!readBinaryBlocks(*in.rdbuf(), number, c))
+    {
+      in.setstate(std::ios::badbit);
+      break;
+    }
+    if (!(in >> c))
+    {
+      break;
+    }
     if (c == '1' || c == '0')
     {
       number = (number << 1) + (c - '0');
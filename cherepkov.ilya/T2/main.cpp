@@ -11,6 +11,7 @@ int main()
   using input_it_t = std::istream_iterator<cherepkov::DataStruct>;
   using output_it_t = std::ostream_iterator<cherepkov::DataStruct>;
 
+  std::ios_base::sync_with_stdio(false);
   std::vector< cherepkov::DataStruct > data;
 
   while (!std::cin.eof())
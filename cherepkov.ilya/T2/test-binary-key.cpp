@@ -0,0 +1,173 @@
+#define BOOST_TEST_MODULE cherepkov_t2_binary_key
+#include <boost/test/included/unit_test.hpp>
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <string>
+#include "input_operators.hpp"
+
+namespace
+{
+  struct OldUllBinValue
+  {
+    unsigned long long& ref;
+  };
+
+  std::istream& operator>>(std::istream& in, OldUllBinValue&& dest)
+  {
+    std::istream::sentry sentry(in);
+    if (!sentry)
+    {
+      return in;
+    }
+    char c = 0;
+    unsigned long long number = 0;
+    in >> cherepkov::DelimiterIO { '0' } >> cherepkov::DelimiterIO { 'b' };
+    while (in >> c)
+    {
+      if (c == '1' || c == '0')
+      {
+        number = (number << 1) + (c - '0');
+      }
+      else
+      {
+        break;
+      }
+    }
+    if (c == ':')
+    {
+      dest.ref = number;
+    }
+    else
+    {
+      in.setstate(std::ios::failbit);
+    }
+    return in;
+  }
+
+  // Hands out the text a few characters at a time, as a pipe does, but keeps
+  // everything read so far behind the get pointer so putbacks succeed
+  class ChunkedBuf: public std::streambuf
+  {
+  public:
+    ChunkedBuf(const std::string& text, size_t chunk):
+      text_(text),
+      chunk_(chunk)
+    {
+      char* begin = &text_[0];
+      setg(begin, begin, begin);
+    }
+
+  protected:
+    int_type underflow() override
+    {
+      char* begin = &text_[0];
+      char* end = begin + text_.size();
+      if (egptr() == end)
+      {
+        return traits_type::eof();
+      }
+      setg(begin, egptr(), std::min(egptr() + chunk_, end));
+      return traits_type::to_int_type(*gptr());
+    }
+
+  private:
+    std::string text_;
+    size_t chunk_;
+  };
+
+  struct Result
+  {
+    unsigned long long value;
+    std::ios::iostate state;
+    std::string rest;
+  };
+
+  template< class Reader >
+  Result readWith(std::streambuf& buf, bool skipws)
+  {
+    std::istream in(&buf);
+    if (!skipws)
+    {
+      in >> std::noskipws;
+    }
+    unsigned long long value = 42;
+    in >> Reader{ value };
+    Result result{ value, in.rdstate(), "" };
+    in.clear();
+    std::getline(in, result.rest, '\0');
+    return result;
+  }
+
+  std::string makeLiteral(std::mt19937& generator)
+  {
+    const char alphabet[] = "0000000111111111 \n\t:2bB\"x";
+    std::uniform_int_distribution< int > kind(0, 9);
+    std::uniform_int_distribution< size_t > length(0, 90);
+    std::uniform_int_distribution< size_t > symbol(0, sizeof(alphabet) - 2);
+    std::uniform_int_distribution< size_t > binary(0, 1);
+    std::string literal = kind(generator) == 0 ? "0B" : "0b";
+    size_t size = length(generator);
+    bool noisy = kind(generator) < 3;
+    for (size_t i = 0; i < size; ++i)
+    {
+      literal += noisy ? alphabet[symbol(generator)] : static_cast< char >('0' + binary(generator));
+    }
+    if (kind(generator) != 0)
+    {
+      literal += ":key3 \"abc\":)";
+    }
+    if (kind(generator) == 0)
+    {
+      literal.resize(std::uniform_int_distribution< size_t >(0, literal.size())(generator));
+    }
+    return literal;
+  }
+
+  void checkSame(const std::string& text, size_t chunk, bool skipws)
+  {
+    ChunkedBuf oldBuf(text, chunk);
+    ChunkedBuf newBuf(text, chunk);
+    Result expected = readWith< OldUllBinValue >(oldBuf, skipws);
+    Result actual = readWith< cherepkov::UllBinValue >(newBuf, skipws);
+    BOOST_TEST_CONTEXT("input \"" << text << "\", chunk " << chunk << ", skipws " << skipws)
+    {
+      BOOST_CHECK_EQUAL(expected.value, actual.value);
+      BOOST_CHECK_EQUAL(expected.state, actual.state);
+      BOOST_CHECK_EQUAL(expected.rest, actual.rest);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(fixed_literals)
+{
+  const char* literals[] = {
+    "0b0:", "0b01:", "0b1:", "0b:", "0b", "0b10101010:", "0b1010101:", "0b101010101:",
+    "0b10 10:", "0b1010 1010 1:", "0b10102:", "0b1\n0:", "0B1:", "0b11111111111111111111:",
+    "0b1111111111111111111111111111111111111111111111111111111111111111:",
+    "0b11111111111111111111111111111111111111111111111111111111111111111:",
+    "0b0000000000000000000000000000000000000000000000000000000000000000000000001:"
+  };
+  for (const char* literal: literals)
+  {
+    for (size_t chunk = 1; chunk <= 17; ++chunk)
+    {
+      checkSame(literal, chunk, true);
+      checkSame(literal, chunk, false);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(fuzzed_literals)
+{
+  std::mt19937 generator(40);
+  std::uniform_int_distribution< size_t > chunk(1, 64);
+  for (size_t i = 0; i < 3000; ++i)
+  {
+    std::string literal = makeLiteral(generator);
+    checkSame(literal, chunk(generator), true);
+    checkSame(literal, literal.size() + 1, true);
+    checkSame(literal, chunk(generator), false);
+  }
+}
@@ -1,6 +1,7 @@
 #include "commands.hpp"
 #include <algorithm>
 #include <exception>
+#include <iterator>
 #include <string>
 
 namespace
@@ -149,61 +150,6 @@ namespace
     out << std::fixed << std::setprecision(1) << result << '\n';
   }
 
-  bool cmpPoint(const cherepkov::Point & p1, const cherepkov::Point & p2)
-  {
-    if (p1.x != p2.x)
-    {
-      return p1.x < p2.x;
-    }
-    else
-    {
-      return p1.y < p2.y;
-    }
-  }
-
-  double crossProduct(const cherepkov::Point & a, const cherepkov::Point & b, const cherepkov::Point & c)
-  {
-    return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
-  }
-  bool isCounterClockwise(const cherepkov::Polygon & polygon)
-  {
-    return crossProduct(polygon.points[0], polygon.points[1], polygon.points[2]) > 0;
-  }
-
-  void sortPolygon(cherepkov::Polygon & poly)
-  {
-    auto itMin = std::min_element(poly.points.begin(), poly.points.end(), cmpPoint);
-    std::rotate(poly.points.begin(), itMin, poly.points.end());
-    if (isCounterClockwise(poly))
-    {
-      std::reverse(poly.points.begin() + 1, poly.points.end());
-    }
-  }
-
-  struct iSame
-  {
-    const cherepkov::Polygon & poly;
-    bool operator()(const cherepkov::Polygon & temp) const
-    {
-      if (temp.points.size() != poly.points.size())
-      {
-        return false;
-      }
-      cherepkov::Polygon sortTemp = temp;
-      sortPolygon(sortTemp);
-      std::vector< cherepkov::Point > diffsPoly;
-      std::vector< cherepkov::Point > diffsTemp;
-      std::adjacent_difference(poly.points.begin(), poly.points.end(), std::back_inserter(diffsPoly));
-      std::adjacent_difference(sortTemp.points.begin(), sortTemp.points.end(), std::back_inserter(diffsTemp));
-      diffsTemp[0] = diffsPoly[0];
-      if (diffsPoly == diffsTemp)
-      {
-        return true;
-      }
-      return false;
-    }
-  };
-
   void inFrameOutput(std::ostream& out, bool res)
   {
     if (res)
@@ -413,9 +359,9 @@ void cherepkov::inFrame(std::istream& in, std::ostream& out, const std::vector<
   inFrameOutput(out, res);
 }
 
-void cherepkov::same(std::istream& in, std::ostream& out, const std::vector< Polygon >& polygons)
+void cherepkov::same(std::istream& in, std::ostream& out, const SameIndex& index)
 {
-  if (polygons.empty())
+  if (index.empty())
   {
     throw std::logic_error("not polygons");
   }
@@ -430,7 +376,21 @@ void cherepkov::same(std::istream& in, std::ostream& out, const std::vector< Pol
     throw std::logic_error("incorrect input");
   }
 
-  sortPolygon(poly);
-  iSame cmp{poly};
-  out << std::count_if(polygons.begin(), polygons.end(), cmp) << '\n';
+  out << index.count(poly) << '\n';
+}
+
+void cherepkov::groups(std::istream& in, std::ostream& out, const SameIndex& index)
+{
+  std::string param;
+  if (!(in >> param) || param != "SAME")
+  {
+    throw std::logic_error("incorrect input");
+  }
+  if (index.empty())
+  {
+    throw std::logic_error("not polygons");
+  }
+  std::vector< size_t > sizes = index.groupSizes();
+  std::copy(sizes.begin(), sizes.end() - 1, std::ostream_iterator< size_t >(out, " "));
+  out << sizes.back() << '\n';
 }
@@ -7,6 +7,7 @@
 #include <map>
 #include <stream_guard.hpp>
 #include "shapes.hpp"
+#include "same_index.hpp"
 
 namespace cherepkov
 {
@@ -17,6 +18,7 @@ namespace cherepkov
   void min(std::istream& in, std::ostream& out, const std::vector< Polygon >& polygons);
   void count(std::istream& in, std::ostream& out, const std::vector< Polygon >& polygons);
   void inFrame(std::istream& in, std::ostream& out, const std::vector< Polygon >& polygons);
-  void same(std::istream& in, std::ostream& out, const std::vector< Polygon >& polygons);
+  void same(std::istream& in, std::ostream& out, const SameIndex& index);
+  void groups(std::istream& in, std::ostream& out, const SameIndex& index);
 }
 #endif
@@ -6,6 +6,7 @@
 #include <limits>
 #include "shapes.hpp"
 #include "commands.hpp"
+#include "same_index.hpp"
 
 int main(int argc, char* argv[])
 {
@@ -37,13 +38,16 @@ int main(int argc, char* argv[])
     }
   }
 
+  SameIndex sameIndex(polygons);
+
   std::map< std::string, std::function< void() > > cmds;
   cmds["AREA"] = std::bind(area, std::ref(std::cin), std::ref(std::cout), std::cref(polygons));
   cmds["MAX"] = std::bind(max, std::ref(std::cin), std::ref(std::cout), std::cref(polygons));
   cmds["MIN"] = std::bind(min, std::ref(std::cin), std::ref(std::cout), std::cref(polygons));
   cmds["COUNT"] = std::bind(count, std::ref(std::cin), std::ref(std::cout), std::cref(polygons));
   cmds["INFRAME"] = std::bind(inFrame, std::ref(std::cin), std::ref(std::cout), std::cref(polygons));
-  cmds["SAME"] = std::bind(same, std::ref(std::cin), std::ref(std::cout), std::cref(polygons));
+  cmds["SAME"] = std::bind(same, std::ref(std::cin), std::ref(std::cout), std::cref(sameIndex));
+  cmds["GROUPS"] = std::bind(groups, std::ref(std::cin), std::ref(std::cout), std::cref(sameIndex));
 
   std::string command;
   while (!(std::cin >> command).eof())
@@ -0,0 +1,133 @@
+#include "same_index.hpp"
+#include <algorithm>
+#include <functional>
+#include <numeric>
+
+namespace
+{
+  bool cmpPoint(const cherepkov::Point & p1, const cherepkov::Point & p2)
+  {
+    if (p1.x != p2.x)
+    {
+      return p1.x < p2.x;
+    }
+    else
+    {
+      return p1.y < p2.y;
+    }
+  }
+
+  double crossProduct(const cherepkov::Point & a, const cherepkov::Point & b, const cherepkov::Point & c)
+  {
+    return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+  }
+
+  bool isCounterClockwise(const cherepkov::Polygon & polygon)
+  {
+    return crossProduct(polygon.points[0], polygon.points[1], polygon.points[2]) > 0;
+  }
+
+  void sortPolygon(cherepkov::Polygon & poly)
+  {
+    auto itMin = std::min_element(poly.points.begin(), poly.points.end(), cmpPoint);
+    std::rotate(poly.points.begin(), itMin, poly.points.end());
+    if (isCounterClockwise(poly))
+    {
+      std::reverse(poly.points.begin() + 1, poly.points.end());
+    }
+  }
+
+  struct ShiftToOrigin
+  {
+    cherepkov::Point origin;
+    cherepkov::Point operator()(const cherepkov::Point & point) const
+    {
+      return point - origin;
+    }
+  };
+
+  struct SameCanonical
+  {
+    const cherepkov::Polygon & canonical;
+    template< class Group >
+    bool operator()(const Group & group) const
+    {
+      return group.canonical.points == canonical.points;
+    }
+  };
+
+  struct HashCombiner
+  {
+    size_t operator()(size_t seed, const cherepkov::Point & point) const
+    {
+      seed ^= std::hash< int >{}(point.x) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+      seed ^= std::hash< int >{}(point.y) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+      return seed;
+    }
+  };
+}
+
+cherepkov::Polygon cherepkov::getCanonical(const Polygon& poly)
+{
+  Polygon canonical = poly;
+  sortPolygon(canonical);
+  Point origin = canonical.points.front();
+  std::transform(canonical.points.begin(), canonical.points.end(), canonical.points.begin(), ShiftToOrigin{origin});
+  return canonical;
+}
+
+size_t cherepkov::hashPoints(const std::vector< Point >& points)
+{
+  return std::accumulate(points.begin(), points.end(), points.size(), HashCombiner{});
+}
+
+cherepkov::SameIndex::SameIndex(const std::vector< Polygon >& polygons):
+  buckets_(),
+  total_(polygons.size())
+{
+  for (auto it = polygons.begin(); it != polygons.end(); ++it)
+  {
+    Polygon canonical = getCanonical(*it);
+    std::vector< Group >& bucket = buckets_[hashPoints(canonical.points)];
+    auto group = std::find_if(bucket.begin(), bucket.end(), SameCanonical{canonical});
+    if (group != bucket.end())
+    {
+      ++group->size;
+    }
+    else
+    {
+      bucket.push_back(Group{std::move(canonical), 1});
+    }
+  }
+}
+
+size_t cherepkov::SameIndex::count(const Polygon& poly) const
+{
+  Polygon canonical = getCanonical(poly);
+  auto bucket = buckets_.find(hashPoints(canonical.points));
+  if (bucket == buckets_.end())
+  {
+    return 0;
+  }
+  auto group = std::find_if(bucket->second.begin(), bucket->second.end(), SameCanonical{canonical});
+  return group != bucket->second.end() ? group->size : 0;
+}
+
+std::vector< size_t > cherepkov::SameIndex::groupSizes() const
+{
+  std::vector< size_t > sizes;
+  for (auto bucket = buckets_.begin(); bucket != buckets_.end(); ++bucket)
+  {
+    for (auto it = bucket->second.begin(); it != bucket->second.end(); ++it)
+    {
+      sizes.push_back(it->size);
+    }
+  }
+  std::sort(sizes.begin(), sizes.end(), std::greater< size_t >());
+  return sizes;
+}
+
+bool cherepkov::SameIndex::empty() const
+{
+  return total_ == 0;
+}
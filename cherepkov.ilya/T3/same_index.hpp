@@ -0,0 +1,32 @@
+#ifndef SAME_INDEX_HPP
+#define SAME_INDEX_HPP
+#include <vector>
+#include <unordered_map>
+#include "shapes.hpp"
+
+namespace cherepkov
+{
+  Polygon getCanonical(const Polygon& poly);
+  size_t hashPoints(const std::vector< Point >& points);
+
+  class SameIndex
+  {
+   public:
+    explicit SameIndex(const std::vector< Polygon >& polygons);
+
+    size_t count(const Polygon& poly) const;
+    std::vector< size_t > groupSizes() const;
+    bool empty() const;
+
+   private:
+    struct Group
+    {
+      Polygon canonical;
+      size_t size;
+    };
+
+    std::unordered_map< size_t, std::vector< Group > > buckets_;
+    size_t total_;
+  };
+}
+#endif
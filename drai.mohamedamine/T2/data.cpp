@@ -14,16 +14,23 @@ bool amine::operator<(const DataStruct& lhs, const DataStruct& rhs)
     return lhs_mod < rhs_mod;
   }
 
-  double lhs_ratio = static_cast< double >(lhs.key2.first) / lhs.key2.second;
-  double rhs_ratio = static_cast< double >(rhs.key2.first) / rhs.key2.second;
-  if (lhs_ratio != rhs_ratio)
+  int ratio_order = compareRatios(lhs.key2, rhs.key2);
+  if (ratio_order != 0)
   {
-    return lhs_ratio < rhs_ratio;
+    return ratio_order < 0;
   }
 
   return lhs.key3.size() < rhs.key3.size();
 }
 
+int amine::compareRatios(const Rational& lhs, const Rational& rhs)
+{
+  using Wide = __int128;
+  Wide lhs_cross = static_cast< Wide >(lhs.first) * static_cast< Wide >(rhs.second);
+  Wide rhs_cross = static_cast< Wide >(rhs.first) * static_cast< Wide >(lhs.second);
+  return (lhs_cross > rhs_cross) - (lhs_cross < rhs_cross);
+}
+
 std::ostream& amine::operator<<(std::ostream& out, const DataStruct& src)
 {
   std::ostream::sentry sentry(out);
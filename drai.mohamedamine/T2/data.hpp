@@ -18,6 +18,9 @@ namespace amine
   std::istream& operator>>(std::istream& in, DataStruct& dest);
   std::ostream& operator<<(std::ostream& out, const DataStruct& dest);
   bool operator<(const DataStruct& lhs, const DataStruct& rhs);
+
+  using Rational = std::pair< long long, unsigned long long >;
+  int compareRatios(const Rational& lhs, const Rational& rhs);
 }
 
 #endif
@@ -4,6 +4,7 @@
 #include <limits>
 #include <vector>
 #include "data.hpp"
+#include "sort.hpp"
 
 int main()
 {
@@ -27,7 +28,7 @@ int main()
     }
   }
 
-  std::sort(data.begin(), data.end());
+  amine::sortData(data);
 
   Out out{ std::cout, "\n" };
   std::copy(data.begin(), data.end(), out);
@@ -0,0 +1,48 @@
+#include "sort.hpp"
+#include <algorithm>
+#include <cmath>
+
+bool amine::operator<(const SortKey& lhs, const SortKey& rhs)
+{
+  if (lhs.modulus != rhs.modulus)
+  {
+    return lhs.modulus < rhs.modulus;
+  }
+
+  int ratio_order = compareRatios(lhs.ratio, rhs.ratio);
+  if (ratio_order != 0)
+  {
+    return ratio_order < 0;
+  }
+
+  if (lhs.length != rhs.length)
+  {
+    return lhs.length < rhs.length;
+  }
+  return lhs.index < rhs.index;
+}
+
+amine::SortKey amine::makeSortKey(const DataStruct& src, size_t index)
+{
+  return SortKey{ std::abs(src.key1), src.key2, src.key3.size(), index };
+}
+
+void amine::sortData(std::vector< DataStruct >& data)
+{
+  std::vector< SortKey > keys;
+  keys.reserve(data.size());
+  for (size_t i = 0; i < data.size(); ++i)
+  {
+    keys.push_back(makeSortKey(data[i], i));
+  }
+
+  std::sort(keys.begin(), keys.end());
+
+  std::vector< DataStruct > sorted;
+  sorted.reserve(data.size());
+  for (auto it = keys.cbegin(); it != keys.cend(); ++it)
+  {
+    sorted.push_back(std::move(data[it->index]));
+  }
+  data.swap(sorted);
+}
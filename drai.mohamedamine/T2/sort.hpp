@@ -0,0 +1,22 @@
+#ifndef SORT_HPP
+#define SORT_HPP
+
+#include <vector>
+#include "data.hpp"
+
+namespace amine
+{
+  struct SortKey
+  {
+    double modulus;
+    Rational ratio;
+    size_t length;
+    size_t index;
+  };
+
+  bool operator<(const SortKey& lhs, const SortKey& rhs);
+  SortKey makeSortKey(const DataStruct& src, size_t index);
+  void sortData(std::vector< DataStruct >& data);
+}
+
+#endif
@@ -5,49 +5,16 @@
 #include <vector>
 #include <functional>
 #include <limits>
+#include <sstream>
 #include <delimiter.hpp>
 
 #include "survival.hpp"
 #include "rest_time.hpp"
 #include "race_predictor.hpp"
+#include "gpx_reader.hpp"
 
 namespace
 {
-  class TimeRangeFilter
-  {
-    time_t start;
-    time_t end;
-  public:
-    TimeRangeFilter(time_t s, time_t e):
-      start(s),
-      end(e)
-    {}
-      bool operator()(const std::pair< time_t, dribas::workout >& session) const
-      {
-        return session.first >= start && session.first <= end;
-      }
-  };
-  struct HeartRateExtractor
-  {
-    int operator()(const std::pair<time_t, dribas:: workout >& session) const
-    {
-      return session.second.avgHeart;
-    }
-  };
-  struct CadenceExtractor {
-    int operator()(const std::pair< time_t, dribas::workout >& session) const
-    {
-      return session.second.cadence;
-    }
-  };
-  struct DistanceExtractor
-  {
-    double operator()(const std::pair< time_t, dribas::workout >& session) const
-    {
-      return session.second.distance;
-    }
-  };
-
   template< class T >
   bool compareStrings(const T& field_val, const std::string& op, const T& value)
   {
@@ -105,6 +72,40 @@ namespace
     return value;
   }
 
+  dribas::Field get_param_field(int param_id)
+  {
+    switch (param_id) {
+      case 2:
+        return dribas::Field::avgHeart;
+      case 3:
+        return dribas::Field::maxHeart;
+      case 4:
+        return dribas::Field::cadence;
+      case 5:
+        return dribas::Field::distance;
+      case 6:
+        return dribas::Field::pace;
+      case 7:
+        return dribas::Field::timeStart;
+      case 8:
+        return dribas::Field::timeEnd;
+      default:
+        throw std::runtime_error("unsupported parameter ID: ");
+    }
+  }
+
+  dribas::Field get_whole_param_field(int param_id)
+  {
+    switch (param_id) {
+      case 5:
+        return dribas::Field::wholeDistance;
+      case 6:
+        return dribas::Field::wholePace;
+      default:
+        return get_param_field(param_id);
+    }
+  }
+
   class WorkoutFilter
   {
   private:
@@ -184,23 +185,6 @@ namespace
     return (it != param_map.end()) ? it->second : 0;
   }
 
-  class GetParamValue
-  {
-  private:
-    int param_id_;
-    std::string param_name_for_errors_;
-  public:
-    GetParamValue(int id, const std::string& name):
-      param_id_(id),
-      param_name_for_errors_(name)
-    {}
-    double operator()(double current_sum, const std::pair< const time_t, dribas::workout >& pair) const
-    {
-      const dribas::workout& w = pair.second;
-      return current_sum + get_workout_numeric_param(w, param_id_);
-    }
-  };
-
   class WorkoutComparator
   {
   private:
@@ -221,17 +205,29 @@ namespace
 
 void dribas::add_training_from_file(std::istream& in, std::ostream& out, suite& trainng)
 {
-  std::string name;
-  in >> name;
-  std::ifstream file(name);
-  workout training;
-  file >> training;
-  if (!in && !in.eof()) {
+  std::string line;
+  std::getline(in, line);
+  std::istringstream names_in(line);
+  std::vector< std::string > names{std::istream_iterator< std::string >(names_in), std::istream_iterator< std::string >()};
+  if (names.empty()) {
     throw std::invalid_argument("invalid file name");
   }
+  std::vector< GpxImport > imports = importGpxFiles(collectGpxFiles(names));
   auto& main_suite = trainng.at(1);
-  main_suite.emplace(training.timeStart, training);
-  out << "Trainings: " << training;
+  size_t added = 0;
+  for (const auto& import: imports) {
+    if (!import.ok) {
+      out << "Cannot read file: " << import.path << '\n';
+      continue;
+    }
+    added += main_suite.emplace(import.training.timeStart, import.training).second;
+    if (imports.size() == 1) {
+      out << "Trainings: " << import.training;
+    }
+  }
+  if (imports.size() != 1) {
+    out << "Imported " << added << " of " << imports.size() << " trainings\n";
+  }
 }
 
 void dribas::show_all_trainings(std::ostream& out, const suite& trainings)
@@ -274,7 +270,7 @@ void dribas::show_trainings_by_date(std::istream& in, std::ostream& out, const s
   }
 }
 
-void dribas::query_trainings(std::istream& in, std::ostream& out, std::map< size_t, std::map< time_t, workout > >& trings)
+void dribas::query_trainings(std::istream& in, std::ostream& out, suite& trings)
 {
   std::string param, op, value_str;
   in >> param >> op >> value_str;
@@ -294,12 +290,13 @@ void dribas::query_trainings(std::istream& in, std::ostream& out, std::map< size
   const auto& source_workouts = it_source_workouts->second;
   WorkoutFilter filter_predicate_obj(param_id, op, value_str, param);
   std::copy_if(source_workouts.begin(), source_workouts.end(), std::inserter(filtered, filtered.end()), filter_predicate_obj);
-  trings[query_id] = filtered;
+  size_t found = filtered.size();
+  trings[query_id] = TrainingList(std::move(filtered));
   out << "Query ID: " << query_id << "\n";
-  out << "Found " << filtered.size() << " matching workouts\n";
+  out << "Found " << found << " matching workouts\n";
 }
 
-void dribas::calculate_average(std::istream& in, std::ostream& out, std::map< size_t, std::map< time_t, workout > >& trings)
+void dribas::calculate_average(std::istream& in, std::ostream& out, suite& trings)
 {
   std::string param_name;
   size_t training_id;
@@ -320,27 +317,77 @@ void dribas::calculate_average(std::istream& in, std::ostream& out, std::map< si
     out << "No workouts found in list ID " << training_id << " to calculate average.\n";
     return;
   }
-  class GetParamValue {
-  private:
-    int param_id_;
-    std::string param_name_for_errors_;
-  public:
-    GetParamValue(int id, const std::string& name) : param_id_(id), param_name_for_errors_(name) {}
-    double operator()(double current_sum, const std::pair<const time_t, dribas::workout>& pair) const {
-      const dribas::workout& w = pair.second;
-      try {
-        return current_sum + get_workout_numeric_param(w, param_id_);
-      } catch (const std::exception& e) {
-        throw std::runtime_error("Error extracting value for average of parameter '" + param_name_for_errors_ + "': " + e.what());
-      }
-    }
-  };
-  double total_sum = std::accumulate(workouts_to_average.begin(), workouts_to_average.end(), 0.0, GetParamValue(param_id, param_name));
-  out << "Average " << param_name << " for list ID " << training_id << ": " << total_sum / workouts_to_average.size() << "\n";
+  const WorkoutSeries& series = workouts_to_average.series();
+  double average = series.average(get_whole_param_field(param_id), 0, series.size());
+  out << "Average " << param_name << " for list ID " << training_id << ": " << average << "\n";
+}
+
+void dribas::range_average(std::istream& in, std::ostream& out, const suite& trainings)
+{
+  std::string param_name;
+  size_t training_id;
+  unsigned int year, month, day;
+  unsigned int end_year, end_month, end_day;
+  in >> param_name >> training_id;
+  in >> year >> DelimiterI{'-'} >> month >> DelimiterI{'-'} >> day;
+  in >> end_year >> DelimiterI{'-'} >> end_month >> DelimiterI{'-'} >> end_day;
+  if (!in) {
+    throw std::invalid_argument("Invalid input for range_average. Usage: <parameter> <id> <YYYY-MM-DD> <YYYY-MM-DD>");
+  }
+  int param_id = get_param(param_name);
+  if (param_id < 2) {
+    throw std::runtime_error("Invalid parameter for average calculation: " + param_name);
+  }
+  auto it_workouts_list = trainings.find(training_id);
+  if (it_workouts_list == trainings.end()) {
+    throw std::runtime_error("Training list with ID " + std::to_string(training_id) + " not found.");
+  }
+  time_t start_date = parse_date(year, month, day);
+  time_t end_date = parse_date(end_year, end_month, end_day) + 86400;
+  const WorkoutSeries& series = it_workouts_list->second.series();
+  size_t first = series.lowerBound(start_date);
+  size_t last = series.lowerBound(end_date);
+  if (first >= last) {
+    out << "No workouts found for specified period.\n";
+    return;
+  }
+  out << "Average " << param_name << " for list ID " << training_id << " over " << last - first << " workouts: ";
+  out << series.average(get_param_field(param_id), first, last) << "\n";
+}
+
+void dribas::rolling_average(std::istream& in, std::ostream& out, const suite& trainings)
+{
+  std::string param_name;
+  size_t training_id;
+  unsigned int days;
+  in >> param_name >> training_id >> days;
+  if (!in || days == 0) {
+    throw std::invalid_argument("Invalid input for rolling_average. Usage: <parameter> <id> <days>");
+  }
+  int param_id = get_param(param_name);
+  if (param_id < 2) {
+    throw std::runtime_error("Invalid parameter for average calculation: " + param_name);
+  }
+  auto it_workouts_list = trainings.find(training_id);
+  if (it_workouts_list == trainings.end()) {
+    throw std::runtime_error("Training list with ID " + std::to_string(training_id) + " not found.");
+  }
+  const WorkoutSeries& series = it_workouts_list->second.series();
+  Field field = get_param_field(param_id);
+  time_t window = static_cast< time_t >(days) * 86400;
+
+  StreamGuard guard(out);
+  out << "Rolling " << days << "-day average " << param_name << " for list ID " << training_id << ":\n";
+  for (size_t i = 0; i < series.size(); ++i) {
+    time_t time = series.time(i);
+    size_t first = series.lowerBound(time - window + 1);
+    out << "  " << std::put_time(std::localtime(&time), "%Y-%m-%d %H:%M") << ": ";
+    out << std::fixed << std::setprecision(2) << series.average(field, first, i + 1) << '\n';
+  }
 }
 
 
-void dribas::add_training_manual(std::istream& in, std::ostream& out, std::map< size_t, std::map< time_t, workout > >& trainings)
+void dribas::add_training_manual(std::istream& in, std::ostream& out, suite& trainings)
 {
   dribas::workout new_workout;
   unsigned int year, month, day, hour, minute;
@@ -501,7 +548,7 @@ void dribas::get_under_trainings(std::istream& in, std::ostream& out, const suit
 void dribas::survival_score(std::ostream& out, const suite& suites) {
   try {
     const auto& main_suite = suites.at(1);
-    out << calculate_survival_score(main_suite);
+    out << calculate_survival_score(main_suite.series(), 0, main_suite.size());
   } catch (const std::out_of_range&) {
     out << "Error: No workouts found in main suite (id=1)\n";
   } catch (const std::exception& e) {
@@ -518,20 +565,20 @@ void dribas::show_rest(std::istream& in, std::ostream& out, const suite& suites)
   }
   time_t date = parse_date(year, month, day);
   time_t next_day = date + 86400;
-  const auto& main_suite = suites.at(1);
-  auto range_start = main_suite.lower_bound(date);
-  auto range_end = main_suite.lower_bound(next_day);
+  const WorkoutSeries& series = suites.at(1).series();
+  size_t range_start = series.lowerBound(date);
+  size_t range_end = series.lowerBound(next_day);
   if (range_start == range_end) {
     out << "  No workouts found for specified date.\n";
     return;
   }
-  int total_recovery = std::accumulate(range_start, range_end, 0, calculate_workout_recovery);
+  int total_recovery = static_cast< int >(series.sum(Field::recovery, range_start, range_end));
 
   StreamGuard guard(out);
   struct tm* date_info = localtime(&date);
   out << "\n=== Recovery Time Estimation ===\n";
   out << "  Date: " << std::put_time(date_info, "%Y-%m-%d") << "\n";
-  out << "  Number of workouts: " << std::distance(range_start, range_end) << "\n";
+  out << "  Number of workouts: " << range_end - range_start << "\n";
   out << "  Total recovery points: " << total_recovery << "\n";
   out << "  Estimated recovery time: " << (total_recovery / 60) << " hours ";
   out << (total_recovery % 60) << " minutes\n\n";
@@ -555,7 +602,8 @@ void dribas::show_rest(std::istream& in, std::ostream& out, const suite& suites)
 
 void dribas::predict_result(std::ostream& out, const suite& tren)
 {
-  auto prediction = predict_result(tren.at(1));
+  const TrainingList& main_suite = tren.at(1);
+  auto prediction = predict_result(main_suite.series(), 0, main_suite.size());
   out << prediction << '\n';
 }
 
@@ -573,39 +621,24 @@ void dribas::analyze_training_segment(std::istream& in, std::ostream& out, const
   if (training_it == trainings.end()) {
     throw std::out_of_range("Training not found");
   }
-  const auto& sessions = training_it->second;
-  std::vector< std::pair< time_t, workout > > filtered_sessions;
-  TimeRangeFilter filter(start_time, end_time);
-  std::copy_if(sessions.begin(), sessions.end(), std::back_inserter(filtered_sessions), filter);
-  if (filtered_sessions.empty()) {
+  const WorkoutSeries& series = training_it->second.series();
+  size_t first = series.lowerBound(start_time);
+  size_t last = series.upperBound(end_time);
+  if (first >= last) {
     throw std::runtime_error("No data found in specified time segment");
   }
-  std::vector< int > heart_rates;
-  HeartRateExtractor hr_extractor;
-  std::transform(filtered_sessions.begin(), filtered_sessions.end(), std::back_inserter(heart_rates), hr_extractor);
-  std::vector< int > cadences;
-  CadenceExtractor cad_extractor;
-  std::transform(filtered_sessions.begin(), filtered_sessions.end(), std::back_inserter(cadences), cad_extractor);
-
-  std::vector< double > distances;
-  DistanceExtractor dist_extractor;
-  std::transform(filtered_sessions.begin(), filtered_sessions.end(), std::back_inserter(distances), dist_extractor);
-
-  double avg_heart = std::accumulate(heart_rates.begin(), heart_rates.end(), 0.0) / heart_rates.size();
-  double avg_cadence = std::accumulate(cadences.begin(), cadences.end(), 0.0) / cadences.size();
-  double avg_distance = std::accumulate(distances.begin(), distances.end(), 0.0) / distances.size();
-
-  auto hr_minmax = std::minmax_element(heart_rates.begin(), heart_rates.end());
-  auto cad_minmax = std::minmax_element(cadences.begin(), cadences.end());
+  double avg_heart = series.average(Field::avgHeart, first, last);
+  double avg_cadence = series.average(Field::cadence, first, last);
+  double avg_distance = series.average(Field::distance, first, last);
 
   out << "Training Segment Analysis (ID: " << training_id << ")\n";
   out << "Time range: " << std::asctime(std::localtime(&start_time));
   out << " - " << std::asctime(std::localtime(&end_time));
-  out << "Sessions analyzed: " << filtered_sessions.size() << "\n";
+  out << "Sessions analyzed: " << last - first << "\n";
   out << "Average Heart Rate: " << std::fixed << std::setprecision(1) << avg_heart << " bpm\n";
-  out << "Min/Max Heart Rate: " << *hr_minmax.first << "/" << *hr_minmax.second << " bpm\n";
+  out << "Min/Max Heart Rate: " << series.minHeart(first, last) << "/" << series.maxHeart(first, last) << " bpm\n";
   out << "Average Cadence: " << std::fixed << std::setprecision(1) << avg_cadence << " rpm\n";
-  out << "Min/Max Cadence: " << *cad_minmax.first << "/" << *cad_minmax.second << " rpm\n";
+  out << "Min/Max Cadence: " << series.minCadence(first, last) << "/" << series.maxCadence(first, last) << " rpm\n";
   out << "Average Distance: " << std::fixed << std::setprecision(2) << avg_distance << " km\n";
 }
 void dribas::delete_training_by_key(std::istream& in, std::ostream& out, suite& trainings)
@@ -3,16 +3,19 @@
 
 #include <map>
 #include "workout.hpp"
+#include "workout_index.hpp"
 
 namespace dribas
 {
-  using suite = std::map< size_t, std::map< time_t, dribas::workout > >;
+  using suite = std::map< size_t, TrainingList >;
   void add_training_manual(std::istream&, std::ostream&, suite&);
   void add_training_from_file(std::istream&, std::ostream&, suite&);
   void show_all_trainings(std::ostream&, const suite&);
   void show_trainings_by_date(std::istream&, std::ostream&, const suite&);
   void query_trainings(std::istream&, std::ostream&, suite&);
   void calculate_average(std::istream&, std::ostream&, suite&);
+  void range_average(std::istream&, std::ostream&, const suite&);
+  void rolling_average(std::istream&, std::ostream&, const suite&);
   void get_top_trainings(std::istream&, std::ostream&, const suite&);
   void get_under_trainings(std::istream&, std::ostream&, const suite&);
   void survival_score(std::ostream&, const suite&);
@@ -0,0 +1,779 @@
+#include "gpx_reader.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+namespace
+{
+  const size_t bufferSize = 1 << 16;
+  const int endOfFile = -1;
+
+  double toRad(double degree)
+  {
+    return degree * std::acos(-1.0) / 180.0;
+  }
+
+  double calculateDistance(double lat1, double lon1, double lat2, double lon2)
+  {
+    const double kEarthRadiusKm = 6371.0;
+    double dLat = toRad(lat2 - lat1);
+    double dLon = toRad(lon2 - lon1);
+    double sinDLat2 = std::sin(dLat / 2);
+    double sinDLon2 = std::sin(dLon / 2);
+    double cosLat1 = std::cos(toRad(lat1));
+    double cosLat2 = std::cos(toRad(lat2));
+    double a = sinDLat2 * sinDLat2;
+    a += cosLat1 * cosLat2 * sinDLon2 * sinDLon2;
+    double c = 2 * std::atan2(std::sqrt(a), std::sqrt(1 - a));
+    double distance = kEarthRadiusKm * c;
+    return distance;
+  }
+
+  bool isSpace(int c)
+  {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+  }
+
+  bool isDigit(char c)
+  {
+    return c >= '0' && c <= '9';
+  }
+
+  bool readDigits(const char*& pos, const char* end, int count, int& value)
+  {
+    value = 0;
+    for (int i = 0; i < count; ++i, ++pos) {
+      if (pos == end || !isDigit(*pos)) {
+        return false;
+      }
+      value = value * 10 + (*pos - '0');
+    }
+    return true;
+  }
+
+  bool readChar(const char*& pos, const char* end, char c)
+  {
+    if (pos == end || *pos != c) {
+      return false;
+    }
+    ++pos;
+    return true;
+  }
+
+  long long daysFromCivil(int year, int month, int day)
+  {
+    year -= month <= 2;
+    const int era = (year >= 0 ? year : year - 399) / 400;
+    const int yoe = year - era * 400;
+    const int doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return static_cast< long long >(era) * 146097 + doe - 719468;
+  }
+
+  int daysInMonth(int year, int month)
+  {
+    const int days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    return (month == 2 && leap) ? 29 : days[month - 1];
+  }
+
+  void trim(const std::string& str, const char*& first, const char*& last)
+  {
+    first = str.data();
+    last = first + str.size();
+    while (first != last && isSpace(*first)) {
+      ++first;
+    }
+    while (last != first && isSpace(*(last - 1))) {
+      --last;
+    }
+  }
+
+  bool parseCoordinate(const std::string& str, double& value)
+  {
+    const char* first = nullptr;
+    const char* last = nullptr;
+    trim(str, first, last);
+    std::string number(first, last);
+    char* end = nullptr;
+    value = std::strtod(number.c_str(), &end);
+    return !number.empty() && end == number.c_str() + number.size();
+  }
+
+  enum class IntParse
+  {
+    ok,
+    invalid,
+    outOfRange
+  };
+
+  IntParse parseInt(const std::string& str, int& value)
+  {
+    const char* first = str.c_str();
+    char* end = nullptr;
+    errno = 0;
+    long result = std::strtol(first, &end, 10);
+    if (end == first) {
+      return IntParse::invalid;
+    }
+    if (errno == ERANGE || result < INT_MIN || result > INT_MAX) {
+      return IntParse::outOfRange;
+    }
+    value = static_cast< int >(result);
+    return IntParse::ok;
+  }
+
+  bool isLocalName(const std::string& qname, const char* local)
+  {
+    const char* name = qname.c_str();
+    const char* colon = std::strchr(name, ':');
+    return std::strcmp(colon ? colon + 1 : name, local) == 0;
+  }
+
+  void decodeEntities(std::string& text)
+  {
+    size_t amp = text.find('&');
+    if (amp == std::string::npos) {
+      return;
+    }
+    std::string result(text, 0, amp);
+    while (amp < text.size()) {
+      size_t semicolon = text.find(';', amp);
+      if (text[amp] != '&' || semicolon == std::string::npos) {
+        result.push_back(text[amp++]);
+        continue;
+      }
+      std::string entity = text.substr(amp + 1, semicolon - amp - 1);
+      long code = -1;
+      if (entity == "lt") {
+        code = '<';
+      } else if (entity == "gt") {
+        code = '>';
+      } else if (entity == "amp") {
+        code = '&';
+      } else if (entity == "quot") {
+        code = '"';
+      } else if (entity == "apos") {
+        code = '\'';
+      } else if (entity.size() > 1 && entity[0] == '#') {
+        bool hex = entity[1] == 'x' || entity[1] == 'X';
+        code = std::strtol(entity.c_str() + (hex ? 2 : 1), nullptr, hex ? 16 : 10);
+      }
+      if (code < 0 || code > 0x7F) {
+        result.push_back(text[amp++]);
+        continue;
+      }
+      result.push_back(static_cast< char >(code));
+      amp = semicolon + 1;
+    }
+    text.swap(result);
+  }
+
+  struct TrackPoint
+  {
+    std::string lat;
+    std::string lon;
+    std::string time;
+    std::string heart;
+    std::string cadence;
+    bool hasLat = false;
+    bool hasLon = false;
+    bool hasTime = false;
+    bool hasHeart = false;
+    bool hasCadence = false;
+  };
+
+  struct TrackTotals
+  {
+    double distance = 0.0;
+    bool hasPrev = false;
+    double prevLat = 0.0;
+    double prevLon = 0.0;
+    bool hasStart = false;
+    time_t start = 0;
+    time_t end = 0;
+    long long heartSum = 0;
+    size_t heartCount = 0;
+    int heartMax = 0;
+    long long cadenceSum = 0;
+    size_t cadenceCount = 0;
+  };
+
+  class GpxParser
+  {
+  public:
+    explicit GpxParser(std::istream& in):
+      in_(in),
+      buffer_(bufferSize),
+      pos_(0),
+      size_(0),
+      depth_(0),
+      capture_(nullptr),
+      captureDepth_(0),
+      tracks_(0),
+      inPoint_(false),
+      hasName_(false)
+    {}
+
+    dribas::workout parse()
+    {
+      while (scanText()) {
+        int c = get();
+        bool ok = false;
+        if (c == '/') {
+          ok = readEndTag();
+        } else if (c == '!') {
+          ok = readDeclaration();
+        } else if (c == '?') {
+          ok = skipPast("?>", nullptr);
+        } else if (c != endOfFile) {
+          unget();
+          ok = readStartTag();
+        }
+        if (!ok) {
+          return fail("malformed element near '" + name_ + "'");
+        }
+      }
+      if (depth_ != 0) {
+        return fail("unexpected end of document");
+      }
+      in_.setstate(std::ios::eofbit);
+      return finish();
+    }
+
+  private:
+    std::istream& in_;
+    std::vector< char > buffer_;
+    size_t pos_;
+    size_t size_;
+    std::vector< std::string > path_;
+    size_t depth_;
+    std::string name_;
+    std::string attrName_;
+    std::string attrValue_;
+    std::string* capture_;
+    size_t captureDepth_;
+    size_t tracks_;
+    bool inPoint_;
+    bool hasName_;
+    std::string workoutName_;
+    TrackPoint point_;
+    TrackTotals totals_;
+
+    bool refill()
+    {
+      size_ = static_cast< size_t >(in_.rdbuf()->sgetn(buffer_.data(), buffer_.size()));
+      pos_ = 0;
+      return size_ > 0;
+    }
+
+    int get()
+    {
+      if (pos_ == size_ && !refill()) {
+        return endOfFile;
+      }
+      return static_cast< unsigned char >(buffer_[pos_++]);
+    }
+
+    int peek()
+    {
+      if (pos_ == size_ && !refill()) {
+        return endOfFile;
+      }
+      return static_cast< unsigned char >(buffer_[pos_]);
+    }
+
+    void unget()
+    {
+      --pos_;
+    }
+
+    bool scanText()
+    {
+      while (pos_ != size_ || refill()) {
+        const char* first = buffer_.data() + pos_;
+        const char* last = buffer_.data() + size_;
+        const char* open = std::find(first, last, '<');
+        if (capture_ && depth_ == captureDepth_) {
+          capture_->append(first, open);
+        }
+        pos_ = static_cast< size_t >(open - buffer_.data());
+        if (open != last) {
+          ++pos_;
+          return true;
+        }
+      }
+      return false;
+    }
+
+    void skipSpaces()
+    {
+      while (isSpace(peek())) {
+        get();
+      }
+    }
+
+    bool skipPast(const char* pattern, std::string* out)
+    {
+      const size_t length = std::strlen(pattern);
+      std::string window;
+      for (int c = get(); c != endOfFile; c = get()) {
+        window.push_back(static_cast< char >(c));
+        if (window.size() > length) {
+          window.erase(0, 1);
+        }
+        if (out) {
+          out->push_back(static_cast< char >(c));
+        }
+        if (window == pattern) {
+          if (out) {
+            out->resize(out->size() - length);
+          }
+          return true;
+        }
+      }
+      return false;
+    }
+
+    bool readName(std::string& name)
+    {
+      name.clear();
+      for (int c = peek(); c != endOfFile && !isSpace(c) && c != '>' && c != '/' && c != '='; c = peek()) {
+        name.push_back(static_cast< char >(get()));
+      }
+      return !name.empty();
+    }
+
+    bool readDeclaration()
+    {
+      if (peek() == '-') {
+        get();
+        return get() == '-' && skipPast("-->", nullptr);
+      }
+      if (peek() == '[') {
+        const char* cdata = "[CDATA[";
+        for (const char* p = cdata; *p; ++p) {
+          if (get() != *p) {
+            return false;
+          }
+        }
+        bool capturing = capture_ && depth_ == captureDepth_;
+        return skipPast("]]>", capturing ? capture_ : nullptr);
+      }
+      return skipPast(">", nullptr);
+    }
+
+    bool readStartTag()
+    {
+      if (!readName(name_)) {
+        return false;
+      }
+      if (depth_ == path_.size()) {
+        path_.emplace_back();
+      }
+      path_[depth_++] = name_;
+      bool point = isTrackPoint();
+      if (point) {
+        beginPoint();
+      }
+
+      bool selfClosing = false;
+      while (true) {
+        skipSpaces();
+        int c = peek();
+        if (c == endOfFile) {
+          return false;
+        }
+        if (c == '>') {
+          get();
+          break;
+        }
+        if (c == '/') {
+          get();
+          if (get() != '>') {
+            return false;
+          }
+          selfClosing = true;
+          break;
+        }
+        if (!readName(attrName_)) {
+          return false;
+        }
+        skipSpaces();
+        if (get() != '=') {
+          return false;
+        }
+        skipSpaces();
+        int quote = get();
+        if (quote != '"' && quote != '\'') {
+          return false;
+        }
+        attrValue_.clear();
+        for (c = get(); c != quote; c = get()) {
+          if (c == endOfFile) {
+            return false;
+          }
+          attrValue_.push_back(static_cast< char >(c));
+        }
+        if (point) {
+          setCoordinate();
+        }
+      }
+
+      startElement();
+      return !selfClosing || endElement();
+    }
+
+    bool readEndTag()
+    {
+      if (!readName(name_)) {
+        return false;
+      }
+      skipSpaces();
+      if (get() != '>' || depth_ == 0 || path_[depth_ - 1] != name_) {
+        return false;
+      }
+      return endElement();
+    }
+
+    bool at(size_t level, const char* local) const
+    {
+      return level < depth_ && isLocalName(path_[level], local);
+    }
+
+    bool inTrack() const
+    {
+      return at(0, "gpx") && at(1, "trk");
+    }
+
+    bool isTrackPoint() const
+    {
+      return depth_ == 4 && inTrack() && at(2, "trkseg") && at(3, "trkpt");
+    }
+
+    void beginPoint()
+    {
+      inPoint_ = true;
+      point_.hasLat = false;
+      point_.hasLon = false;
+      point_.hasTime = false;
+      point_.hasHeart = false;
+      point_.hasCadence = false;
+    }
+
+    void setCoordinate()
+    {
+      if (attrName_ == "lat") {
+        point_.lat = attrValue_;
+        point_.hasLat = true;
+      } else if (attrName_ == "lon") {
+        point_.lon = attrValue_;
+        point_.hasLon = true;
+      }
+    }
+
+    void startCapture(std::string& target, bool& flag)
+    {
+      target.clear();
+      flag = true;
+      capture_ = &target;
+      captureDepth_ = depth_;
+    }
+
+    void startElement()
+    {
+      if (depth_ == 2 && inTrack()) {
+        ++tracks_;
+      } else if (depth_ == 3 && inTrack() && at(2, "trkseg")) {
+        totals_.hasPrev = false;
+      } else if (depth_ == 3 && inTrack() && at(2, "name") && tracks_ == 1 && !hasName_) {
+        startCapture(workoutName_, hasName_);
+      } else if (inPoint_ && depth_ == 5 && at(4, "time")) {
+        startCapture(point_.time, point_.hasTime);
+      } else if (inPoint_ && depth_ == 7 && at(4, "extensions") && at(5, "TrackPointExtension")) {
+        if (at(6, "hr")) {
+          startCapture(point_.heart, point_.hasHeart);
+        } else if (at(6, "cad")) {
+          startCapture(point_.cadence, point_.hasCadence);
+        }
+      }
+    }
+
+    bool endElement()
+    {
+      if (capture_ && depth_ == captureDepth_) {
+        decodeEntities(*capture_);
+        capture_ = nullptr;
+      }
+      if (inPoint_ && depth_ == 4) {
+        commitPoint();
+        inPoint_ = false;
+      }
+      --depth_;
+      return true;
+    }
+
+    void commitPoint()
+    {
+      if (point_.hasTime) {
+        time_t timestamp = 0;
+        if (dribas::parseIsoTime(point_.time, timestamp)) {
+          if (!totals_.hasStart) {
+            totals_.start = timestamp;
+            totals_.hasStart = true;
+          }
+          totals_.end = timestamp;
+        } else {
+          std::cerr << "Time error: '" << point_.time << "'\n";
+        }
+      }
+
+      if (!point_.hasLat || !point_.hasLon) {
+        std::cerr << "No coords in trkpt\n";
+        totals_.hasPrev = false;
+        return;
+      }
+      double lat = 0.0;
+      double lon = 0.0;
+      if (!parseCoordinate(point_.lat, lat) || !parseCoordinate(point_.lon, lon)) {
+        std::cerr << "Coord error: '" << point_.lat << "', '" << point_.lon << "'\n";
+        totals_.hasPrev = false;
+        return;
+      }
+      if (totals_.hasPrev) {
+        totals_.distance += calculateDistance(totals_.prevLat, totals_.prevLon, lat, lon);
+      }
+      totals_.prevLat = lat;
+      totals_.prevLon = lon;
+      totals_.hasPrev = true;
+
+      int value = 0;
+      if (point_.hasHeart) {
+        IntParse status = parseInt(point_.heart, value);
+        if (status == IntParse::ok) {
+          totals_.heartMax = totals_.heartCount ? std::max(totals_.heartMax, value) : value;
+          totals_.heartSum += value;
+          ++totals_.heartCount;
+        } else {
+          std::cerr << (status == IntParse::invalid ? "HR not number: '" : "HR out of range: '") << point_.heart << "'\n";
+        }
+      }
+      if (point_.hasCadence) {
+        IntParse status = parseInt(point_.cadence, value);
+        if (status == IntParse::ok) {
+          totals_.cadenceSum += value;
+          ++totals_.cadenceCount;
+        } else {
+          std::cerr << (status == IntParse::invalid ? "Cadence not number: '" : "Cadence out of range: '");
+          std::cerr << point_.cadence << "'\n";
+        }
+      }
+    }
+
+    dribas::workout fail(const std::string& message)
+    {
+      std::cerr << "XML error: " << message << '\n';
+      return dribas::workout{};
+    }
+
+    dribas::workout finish() const
+    {
+      dribas::workout result;
+      result.name = hasName_ ? workoutName_ : "Unknown workout";
+      result.distance = totals_.distance;
+      if (totals_.heartCount) {
+        result.avgHeart = static_cast< int >(totals_.heartSum / static_cast< long long >(totals_.heartCount));
+        result.maxHeart = totals_.heartMax;
+      }
+      if (totals_.cadenceCount) {
+        result.cadence = static_cast< int >(totals_.cadenceSum / static_cast< long long >(totals_.cadenceCount));
+      }
+      result.timeStart = totals_.start;
+      result.timeEnd = totals_.end;
+
+      if (result.distance > 0 && result.timeEnd > result.timeStart) {
+        long long durationSeconds = result.timeEnd - result.timeStart;
+        double durationMinutes = static_cast< double >(durationSeconds) / 60.0;
+        result.avgPaceMinPerKm = durationMinutes / result.distance;
+      }
+      return result;
+    }
+  };
+
+  bool isGpxName(const std::string& name)
+  {
+    const std::string extension = ".gpx";
+    if (name.size() <= extension.size()) {
+      return false;
+    }
+    auto first = name.end() - extension.size();
+    for (size_t i = 0; i < extension.size(); ++i, ++first) {
+      if (std::tolower(static_cast< unsigned char >(*first)) != extension[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool isDirectory(const std::string& path)
+  {
+    struct stat info;
+    return ::stat(path.c_str(), &info) == 0 && S_ISDIR(info.st_mode);
+  }
+
+  bool isRegularFile(const std::string& path)
+  {
+    struct stat info;
+    return ::stat(path.c_str(), &info) == 0 && S_ISREG(info.st_mode);
+  }
+
+  void listGpxFiles(const std::string& directory, std::vector< std::string >& files)
+  {
+    DIR* dir = ::opendir(directory.c_str());
+    if (!dir) {
+      return;
+    }
+    std::vector< std::string > found;
+    for (dirent* entry = ::readdir(dir); entry; entry = ::readdir(dir)) {
+      std::string path = directory + '/' + entry->d_name;
+      if (isGpxName(entry->d_name) && isRegularFile(path)) {
+        found.push_back(path);
+      }
+    }
+    ::closedir(dir);
+    std::sort(found.begin(), found.end());
+    files.insert(files.end(), found.begin(), found.end());
+  }
+
+  struct ImportWorker
+  {
+    std::vector< dribas::GpxImport >& imports;
+    std::atomic< size_t >& next;
+
+    void operator()() const
+    {
+      for (size_t i = next++; i < imports.size(); i = next++) {
+        dribas::GpxImport& import = imports[i];
+        try {
+          std::ifstream file(import.path, std::ios::binary);
+          if (file) {
+            import.training = dribas::parseGpx(file);
+            import.ok = true;
+          }
+        } catch (const std::exception& e) {
+          std::cerr << "Import error: " << import.path << ": " << e.what() << '\n';
+        }
+      }
+    }
+  };
+}
+
+bool dribas::parseIsoTime(const std::string& str, time_t& result)
+{
+  const char* pos = nullptr;
+  const char* end = nullptr;
+  trim(str, pos, end);
+
+  int year = 0;
+  int month = 0;
+  int day = 0;
+  int hour = 0;
+  int minute = 0;
+  int second = 0;
+  bool ok = readDigits(pos, end, 4, year) && readChar(pos, end, '-');
+  ok = ok && readDigits(pos, end, 2, month) && readChar(pos, end, '-');
+  ok = ok && readDigits(pos, end, 2, day) && readChar(pos, end, 'T');
+  ok = ok && readDigits(pos, end, 2, hour) && readChar(pos, end, ':');
+  ok = ok && readDigits(pos, end, 2, minute) && readChar(pos, end, ':');
+  ok = ok && readDigits(pos, end, 2, second);
+  if (!ok) {
+    return false;
+  }
+  if (readChar(pos, end, '.')) {
+    if (pos == end || !isDigit(*pos)) {
+      return false;
+    }
+    while (pos != end && isDigit(*pos)) {
+      ++pos;
+    }
+  }
+
+  long long offset = 0;
+  if (readChar(pos, end, 'Z')) {
+    offset = 0;
+  } else if (pos != end && (*pos == '+' || *pos == '-')) {
+    int sign = (*pos++ == '-') ? -1 : 1;
+    int offsetHours = 0;
+    int offsetMinutes = 0;
+    if (!readDigits(pos, end, 2, offsetHours)) {
+      return false;
+    }
+    readChar(pos, end, ':');
+    if (!readDigits(pos, end, 2, offsetMinutes) || offsetHours > 23 || offsetMinutes > 59) {
+      return false;
+    }
+    offset = sign * (offsetHours * 3600LL + offsetMinutes * 60LL);
+  }
+  if (pos != end) {
+    return false;
+  }
+  if (month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month) ||
+      hour > 23 || minute > 59 || second > 59) {
+    return false;
+  }
+
+  long long seconds = daysFromCivil(year, month, day) * 86400LL + hour * 3600LL + minute * 60LL + second;
+  result = static_cast< time_t >(seconds - offset);
+  return true;
+}
+
+dribas::workout dribas::parseGpx(std::istream& gpxStream)
+{
+  GpxParser parser(gpxStream);
+  return parser.parse();
+}
+
+std::vector< std::string > dribas::collectGpxFiles(const std::vector< std::string >& names)
+{
+  std::vector< std::string > files;
+  for (const auto& name: names) {
+    if (isDirectory(name)) {
+      listGpxFiles(name, files);
+    } else {
+      files.push_back(name);
+    }
+  }
+  return files;
+}
+
+std::vector< dribas::GpxImport > dribas::importGpxFiles(const std::vector< std::string >& paths)
+{
+  std::vector< GpxImport > imports(paths.size());
+  for (size_t i = 0; i < paths.size(); ++i) {
+    imports[i].path = paths[i];
+  }
+
+  std::atomic< size_t > next(0);
+  size_t threads = std::max(1u, std::thread::hardware_concurrency());
+  threads = std::min(threads, imports.size());
+  std::vector< std::thread > workers;
+  for (size_t i = 1; i < threads; ++i) {
+    workers.emplace_back(ImportWorker{imports, next});
+  }
+  ImportWorker{imports, next}();
+  for (auto& worker: workers) {
+    worker.join();
+  }
+  return imports;
+}
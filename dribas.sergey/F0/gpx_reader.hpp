@@ -0,0 +1,23 @@
+#ifndef GPX_READER_HPP
+#define GPX_READER_HPP
+
+#include <ctime>
+#include <string>
+#include <vector>
+#include "workout.hpp"
+
+namespace dribas
+{
+  struct GpxImport
+  {
+    std::string path;
+    bool ok = false;
+    workout training;
+  };
+
+  bool parseIsoTime(const std::string& str, time_t& result);
+  std::vector< std::string > collectGpxFiles(const std::vector< std::string >& names);
+  std::vector< GpxImport > importGpxFiles(const std::vector< std::string >& paths);
+}
+
+#endif
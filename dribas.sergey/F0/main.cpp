@@ -10,8 +10,8 @@
 
 int main()
 {
-  std::map< size_t, std::map< time_t, dribas::workout > > suite;
-  suite[1] = std::map< time_t, dribas::workout >();
+  dribas::suite suite;
+  suite[1] = dribas::TrainingList();
   std::map< std::string, std::function< void() > > cmds;
   cmds["add_training_manual"] = std::bind(dribas::add_training_manual, std::ref(std::cin), std::ref(std::cout), std::ref(suite));
   cmds["add_training_from_file"] = std::bind(dribas::add_training_from_file, std::ref(std::cin), std::ref(std::cout), std::ref(suite));
@@ -19,6 +19,8 @@ int main()
   cmds["show_trainings_by_date"] = std::bind(dribas::show_trainings_by_date, std::ref(std::cin), std::ref(std::cout), std::cref(suite));
   cmds["query_trainings"] = std::bind(dribas::query_trainings, std::ref(std::cin), std::ref(std::cout), std::ref(suite));
   cmds["calculate_average"] = std::bind(dribas::calculate_average, std::ref(std::cin), std::ref(std::cout), std::ref(suite));
+  cmds["range_average"] = std::bind(dribas::range_average, std::ref(std::cin), std::ref(std::cout), std::cref(suite));
+  cmds["rolling_average"] = std::bind(dribas::rolling_average, std::ref(std::cin), std::ref(std::cout), std::cref(suite));
   cmds["get_top_trainings"] = std::bind(dribas::get_top_trainings, std::ref(std::cin), std::ref(std::cout), std::cref(suite));
   cmds["get_under_trainings"] = std::bind(dribas::get_under_trainings, std::ref(std::cin), std::ref(std::cout), std::cref(suite));
   cmds["survival_score"] = std::bind(dribas::survival_score, std::ref(std::cout), std::cref(suite));
@@ -23,41 +23,16 @@ namespace
     ss << std::setfill('0') << std::setw(2) << minutes << ":" << std::setfill('0') << std::setw(2) << seconds;
     return ss.str();
   }
-
-  struct WorkoutStats
-  {
-    size_t count;
-    double max_distance;
-    double min_pace;
-
-    WorkoutStats():
-      count(0),
-      max_distance(0.0),
-      min_pace(std::numeric_limits< double >::max())
-    {}
-    WorkoutStats operator()(WorkoutStats stats, const std::pair<time_t, dribas::workout>& entry) const
-    {
-      const auto& w = entry.second;
-      if (w.distance > 0 && w.avgPaceMinPerKm > 0) {
-        stats.count++;
-        stats.max_distance = std::max(stats.max_distance, w.distance);
-        stats.min_pace = std::min(stats.min_pace, w.avgPaceMinPerKm);
-      }
-      return stats;
-    }
-  };
 }
 
-dribas::RacePrediction dribas::predict_result(const std::map<time_t, workout>& workouts)
+dribas::RacePrediction dribas::predict_result(const WorkoutSeries& series, size_t first, size_t last)
 {
   RacePrediction prediction = { 0.0, 0.0, 0.0, 0.0 };
-  WorkoutStats stats = std::accumulate(workouts.begin(), workouts.end(), WorkoutStats{}, WorkoutStats());
-
-  if (stats.count == 0) {
+  if (first >= last || series.sum(Field::predictable, first, last) == 0) {
     return prediction;
   }
-  double max_distance = stats.max_distance;
-  double best_pace = stats.min_pace;
+  double max_distance = series.maxPredictableDistance(first, last);
+  double best_pace = series.minPredictablePace(first, last);
   prediction.fiveKm = best_pace * 1.06;
   prediction.tenKm = best_pace * 1.08;
   if (max_distance >= 10.0) {
@@ -3,7 +3,7 @@
 
 #include <map>
 #include <ostream>
-#include "workout.hpp"
+#include "workout_index.hpp"
 
 namespace dribas
 {
@@ -14,7 +14,7 @@ namespace dribas
     double halfMarathon;
     double marathon;
   };
-  RacePrediction predict_result(const std::map< time_t, workout >&);
+  RacePrediction predict_result(const WorkoutSeries&, size_t first, size_t last);
   std::ostream& operator<<(std::ostream&, const RacePrediction&);
 
 }
@@ -10,8 +10,3 @@ int dribas::get_rest_time(const workout& w)
   }
   return static_cast< int >(trimp);
 }
-
-int dribas::calculate_workout_recovery(int sum, const std::pair<time_t, workout>& pair)
-{
-  return sum + get_rest_time(pair.second);
-}
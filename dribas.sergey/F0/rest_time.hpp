@@ -6,7 +6,6 @@
 namespace dribas
 {
   int get_rest_time(const workout&);
-  int calculate_workout_recovery(int sum, const std::pair< time_t, workout >& pair);
 }
 
 #endif
@@ -2,16 +2,6 @@
 
 using Accum = dribas::WorkoutAccumulator;
 
-Accum dribas::accumulate_workout_data(Accum acc, const std::pair< time_t, dribas::workout >& entry)
-{
-  const auto& w = entry.second;
-  acc.totalDistance += w.distance;
-  acc.totalDuration += (w.timeEnd - w.timeStart) / 3600.0;
-  acc.strengthSum += (w.maxHeart - w.avgHeart) + w.cadence;
-  acc.workoutCount++;
-  return acc;
-}
-
 std::string dribas::RecommendationGenerator::operator()(const std::pair< double, std::string >& rule) const
 {
   if ((rule.first == 50.0 && score.enduranceScore < rule.first) ||
@@ -21,14 +11,17 @@ std::string dribas::RecommendationGenerator::operator()(const std::pair< double,
   return std::string();
 }
 
-dribas::SurvivalScore dribas::calculate_survival_score(const std::map< time_t, dribas::workout >& workouts)
+dribas::SurvivalScore dribas::calculate_survival_score(const WorkoutSeries& series, size_t first, size_t last)
 {
   dribas::SurvivalScore score{};
-  if (workouts.empty()) {
+  if (first >= last) {
     return score;
   }
-  auto accum = Accum{};
-  const auto totals = std::accumulate(workouts.begin(), workouts.end(), accum, dribas::accumulate_workout_data);
+  Accum totals;
+  totals.totalDistance = series.sum(Field::distance, first, last);
+  totals.totalDuration = series.sum(Field::durationHours, first, last);
+  totals.strengthSum = series.sum(Field::strength, first, last);
+  totals.workoutCount = static_cast< int >(last - first);
   score.enduranceScore = (totals.totalDistance * totals.totalDuration) / totals.workoutCount;
   score.strengthScore = totals.strengthSum / totals.workoutCount;
 
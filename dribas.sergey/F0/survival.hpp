@@ -11,7 +11,7 @@
 #include <string>
 
 #include <streamGuard.hpp>
-#include "workout.hpp"
+#include "workout_index.hpp"
 
 namespace dribas
 {
@@ -33,18 +33,13 @@ namespace dribas
     int workoutCount = 0;
   };
 
-  WorkoutAccumulator accumulate_workout_data
-  (
-    WorkoutAccumulator acc,
-    const std::pair< time_t, workout >& entry);
-
   struct RecommendationGenerator
   {
     const SurvivalScore& score;
     std::string operator()(const std::pair< double, std::string >& rule) const;
   };
 
-  SurvivalScore calculate_survival_score(const std::map< time_t, workout >& workouts);
+  SurvivalScore calculate_survival_score(const WorkoutSeries& series, size_t first, size_t last);
 
   std::ostream& operator<<(std::ostream& os, const SurvivalScore& score);
 
@@ -28,7 +28,7 @@ namespace dribas
     std::map< size_t, std::map< time_t, workout > > suite;
   };
 
-  workout parseGpx(const std::string& gpxContent);
+  workout parseGpx(std::istream& gpxStream);
 
   std::istream& operator>>(std::istream& is, workout& w);
   std::ostream& operator<<(std::ostream& os, const workout& w);
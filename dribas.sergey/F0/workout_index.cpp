@@ -0,0 +1,221 @@
+#include "workout_index.hpp"
+#include <limits>
+#include "rest_time.hpp"
+
+namespace
+{
+  const size_t fieldCount = static_cast< size_t >(dribas::Field::predictable) + 1;
+
+  bool isPredictable(const dribas::workout& w)
+  {
+    return w.distance > 0 && w.avgPaceMinPerKm > 0;
+  }
+
+  double fieldValue(const dribas::workout& w, dribas::Field field)
+  {
+    switch (field) {
+      case dribas::Field::avgHeart:
+        return w.avgHeart;
+      case dribas::Field::maxHeart:
+        return w.maxHeart;
+      case dribas::Field::cadence:
+        return w.cadence;
+      case dribas::Field::distance:
+        return w.distance;
+      case dribas::Field::pace:
+        return w.avgPaceMinPerKm;
+      case dribas::Field::timeStart:
+        return w.timeStart;
+      case dribas::Field::timeEnd:
+        return w.timeEnd;
+      case dribas::Field::durationHours:
+        return (w.timeEnd - w.timeStart) / 3600.0;
+      case dribas::Field::recovery:
+        return dribas::get_rest_time(w);
+      case dribas::Field::strength:
+        return (w.maxHeart - w.avgHeart) + w.cadence;
+      case dribas::Field::wholeDistance:
+        return static_cast< long long >(w.distance);
+      case dribas::Field::wholePace:
+        return static_cast< long long >(w.avgPaceMinPerKm);
+      case dribas::Field::predictable:
+        return isPredictable(w) ? 1.0 : 0.0;
+    }
+    return 0.0;
+  }
+}
+
+dribas::WorkoutSeries::WorkoutSeries(const std::map< time_t, workout >& workouts):
+  times_(),
+  prefix_(fieldCount, std::vector< double >(1, 0.0))
+{
+  const size_t count = workouts.size();
+  times_.reserve(count);
+  for (auto& column: prefix_) {
+    column.reserve(count + 1);
+  }
+  std::vector< int > hearts;
+  std::vector< int > cadences;
+  std::vector< double > distances;
+  std::vector< double > paces;
+  hearts.reserve(count);
+  cadences.reserve(count);
+  distances.reserve(count);
+  paces.reserve(count);
+
+  for (const auto& entry: workouts) {
+    const workout& w = entry.second;
+    times_.push_back(entry.first);
+    for (size_t field = 0; field < fieldCount; ++field) {
+      prefix_[field].push_back(prefix_[field].back() + fieldValue(w, static_cast< Field >(field)));
+    }
+    hearts.push_back(w.avgHeart);
+    cadences.push_back(w.cadence);
+    distances.push_back(isPredictable(w) ? w.distance : 0.0);
+    paces.push_back(isPredictable(w) ? w.avgPaceMinPerKm : std::numeric_limits< double >::max());
+  }
+
+  minHeart_.assign(hearts, std::numeric_limits< int >::max());
+  maxHeart_.assign(hearts, std::numeric_limits< int >::min());
+  minCadence_.assign(cadences, std::numeric_limits< int >::max());
+  maxCadence_.assign(cadences, std::numeric_limits< int >::min());
+  maxDistance_.assign(distances, 0.0);
+  minPace_.assign(paces, std::numeric_limits< double >::max());
+}
+
+size_t dribas::WorkoutSeries::size() const
+{
+  return times_.size();
+}
+
+time_t dribas::WorkoutSeries::time(size_t i) const
+{
+  return times_[i];
+}
+
+size_t dribas::WorkoutSeries::lowerBound(time_t time) const
+{
+  return std::lower_bound(times_.begin(), times_.end(), time) - times_.begin();
+}
+
+size_t dribas::WorkoutSeries::upperBound(time_t time) const
+{
+  return std::upper_bound(times_.begin(), times_.end(), time) - times_.begin();
+}
+
+double dribas::WorkoutSeries::sum(Field field, size_t first, size_t last) const
+{
+  const std::vector< double >& column = prefix_[static_cast< size_t >(field)];
+  return column[last] - column[first];
+}
+
+double dribas::WorkoutSeries::average(Field field, size_t first, size_t last) const
+{
+  return sum(field, first, last) / (last - first);
+}
+
+int dribas::WorkoutSeries::minHeart(size_t first, size_t last) const
+{
+  return minHeart_.query(first, last);
+}
+
+int dribas::WorkoutSeries::maxHeart(size_t first, size_t last) const
+{
+  return maxHeart_.query(first, last);
+}
+
+int dribas::WorkoutSeries::minCadence(size_t first, size_t last) const
+{
+  return minCadence_.query(first, last);
+}
+
+int dribas::WorkoutSeries::maxCadence(size_t first, size_t last) const
+{
+  return maxCadence_.query(first, last);
+}
+
+double dribas::WorkoutSeries::maxPredictableDistance(size_t first, size_t last) const
+{
+  return maxDistance_.query(first, last);
+}
+
+double dribas::WorkoutSeries::minPredictablePace(size_t first, size_t last) const
+{
+  return minPace_.query(first, last);
+}
+
+dribas::TrainingList::TrainingList(container_type workouts):
+  workouts_(std::move(workouts)),
+  series_()
+{}
+
+dribas::TrainingList::TrainingList(const TrainingList& other):
+  workouts_(other.workouts_),
+  series_()
+{}
+
+dribas::TrainingList& dribas::TrainingList::operator=(const TrainingList& other)
+{
+  if (this != &other) {
+    workouts_ = other.workouts_;
+    series_.reset();
+  }
+  return *this;
+}
+
+dribas::TrainingList::const_iterator dribas::TrainingList::begin() const
+{
+  return workouts_.begin();
+}
+
+dribas::TrainingList::const_iterator dribas::TrainingList::end() const
+{
+  return workouts_.end();
+}
+
+dribas::TrainingList::const_iterator dribas::TrainingList::lower_bound(time_t time) const
+{
+  return workouts_.lower_bound(time);
+}
+
+dribas::TrainingList::const_iterator dribas::TrainingList::upper_bound(time_t time) const
+{
+  return workouts_.upper_bound(time);
+}
+
+size_t dribas::TrainingList::size() const
+{
+  return workouts_.size();
+}
+
+bool dribas::TrainingList::empty() const
+{
+  return workouts_.empty();
+}
+
+std::pair< dribas::TrainingList::const_iterator, bool > dribas::TrainingList::emplace(time_t time,
+    const workout& training)
+{
+  auto result = workouts_.emplace(time, training);
+  if (result.second) {
+    series_.reset();
+  }
+  return result;
+}
+
+size_t dribas::TrainingList::erase(time_t time)
+{
+  size_t erased = workouts_.erase(time);
+  if (erased) {
+    series_.reset();
+  }
+  return erased;
+}
+
+const dribas::WorkoutSeries& dribas::TrainingList::series() const
+{
+  if (!series_) {
+    series_.reset(new WorkoutSeries(workouts_));
+  }
+  return *series_;
+}
@@ -0,0 +1,134 @@
+#ifndef WORKOUT_INDEX_HPP
+#define WORKOUT_INDEX_HPP
+
+#include <algorithm>
+#include <ctime>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+#include "workout.hpp"
+
+namespace dribas
+{
+  enum class Field
+  {
+    avgHeart,
+    maxHeart,
+    cadence,
+    distance,
+    pace,
+    timeStart,
+    timeEnd,
+    durationHours,
+    recovery,
+    strength,
+    wholeDistance,
+    wholePace,
+    predictable
+  };
+
+  template< class T, class Better >
+  class RangeTable
+  {
+  public:
+    void assign(const std::vector< T >& values, T identity)
+    {
+      size_ = values.size();
+      identity_ = identity;
+      tree_.assign(2 * size_, identity);
+      std::copy(values.begin(), values.end(), tree_.begin() + size_);
+      for (size_t i = size_; i-- > 1;) {
+        tree_[i] = pick(tree_[2 * i], tree_[2 * i + 1]);
+      }
+    }
+
+    T query(size_t first, size_t last) const
+    {
+      T result = identity_;
+      for (first += size_, last += size_; first < last; first /= 2, last /= 2) {
+        if (first & 1) {
+          result = pick(result, tree_[first++]);
+        }
+        if (last & 1) {
+          result = pick(result, tree_[--last]);
+        }
+      }
+      return result;
+    }
+
+  private:
+    std::vector< T > tree_;
+    size_t size_ = 0;
+    T identity_ = T();
+    Better better_;
+
+    T pick(const T& a, const T& b) const
+    {
+      return better_(b, a) ? b : a;
+    }
+  };
+
+  class WorkoutSeries
+  {
+  public:
+    explicit WorkoutSeries(const std::map< time_t, workout >& workouts);
+
+    size_t size() const;
+    time_t time(size_t i) const;
+    size_t lowerBound(time_t time) const;
+    size_t upperBound(time_t time) const;
+
+    double sum(Field field, size_t first, size_t last) const;
+    double average(Field field, size_t first, size_t last) const;
+    int minHeart(size_t first, size_t last) const;
+    int maxHeart(size_t first, size_t last) const;
+    int minCadence(size_t first, size_t last) const;
+    int maxCadence(size_t first, size_t last) const;
+    double maxPredictableDistance(size_t first, size_t last) const;
+    double minPredictablePace(size_t first, size_t last) const;
+
+  private:
+    std::vector< time_t > times_;
+    std::vector< std::vector< double > > prefix_;
+    RangeTable< int, std::less< int > > minHeart_;
+    RangeTable< int, std::greater< int > > maxHeart_;
+    RangeTable< int, std::less< int > > minCadence_;
+    RangeTable< int, std::greater< int > > maxCadence_;
+    RangeTable< double, std::greater< double > > maxDistance_;
+    RangeTable< double, std::less< double > > minPace_;
+  };
+
+  class TrainingList
+  {
+  public:
+    using container_type = std::map< time_t, workout >;
+    using value_type = container_type::value_type;
+    using const_iterator = container_type::const_iterator;
+
+    TrainingList() = default;
+    explicit TrainingList(container_type workouts);
+    TrainingList(const TrainingList& other);
+    TrainingList(TrainingList&& other) = default;
+    TrainingList& operator=(const TrainingList& other);
+    TrainingList& operator=(TrainingList&& other) = default;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator lower_bound(time_t time) const;
+    const_iterator upper_bound(time_t time) const;
+    size_t size() const;
+    bool empty() const;
+
+    std::pair< const_iterator, bool > emplace(time_t time, const workout& training);
+    size_t erase(time_t time);
+
+    const WorkoutSeries& series() const;
+
+  private:
+    container_type workouts_;
+    mutable std::unique_ptr< WorkoutSeries > series_;
+  };
+}
+
+#endif
@@ -1,11 +1,27 @@
 #include "data.hpp"
 
 #include <iomanip>
+#include <limits>
 #include <sstream>
 
 #include <streamGuard.hpp>
 #include <delimiter.hpp>
 
+namespace
+{
+  int hexDigit(char c) noexcept
+  {
+    if (c >= '0' && c <= '9') {
+      return c - '0';
+    }
+    char lower = c | 0x20;
+    if (lower >= 'a' && lower <= 'f') {
+      return lower - 'a' + 10;
+    }
+    return -1;
+  }
+}
+
 namespace dribas
 {
   bool compare(const DataStruct& lhs, const DataStruct& rhs) noexcept
@@ -82,7 +98,70 @@ namespace dribas
     }
     StreamGuard guard(in);
 
-    return in >> DelimiterI{ '0' } >> DelimiterI{ 'x' } >> std::hex >> ull.ref;
+    return in >> DelimiterI{ '0' } >> DelimiterI{ 'x' } >> HexI{ ull.ref };
+  }
+
+  std::istream& operator>>(std::istream& in, HexI&& hex)
+  {
+    std::istream::sentry sentry(in);
+    if (!sentry) {
+      return in;
+    }
+    using traits = std::istream::traits_type;
+    using ull = unsigned long long;
+    constexpr ull max = std::numeric_limits< ull >::max();
+    constexpr ull smax = max / 16;
+
+    std::streambuf* buf = in.rdbuf();
+    traits::int_type c = buf->sgetc();
+    bool negative = traits::eq_int_type(c, traits::to_int_type('-'));
+    if (negative || traits::eq_int_type(c, traits::to_int_type('+'))) {
+      c = buf->snextc();
+    }
+    bool foundZero = false;
+    if (traits::eq_int_type(c, traits::to_int_type('0'))) {
+      foundZero = true;
+      c = buf->snextc();
+      if (traits::eq_int_type(c, traits::to_int_type('x')) || traits::eq_int_type(c, traits::to_int_type('X'))) {
+        foundZero = false;
+        c = buf->snextc();
+      }
+    }
+
+    bool foundDigit = false;
+    bool overflow = false;
+    ull result = 0;
+    while (!traits::eq_int_type(c, traits::eof())) {
+      int digit = hexDigit(traits::to_char_type(c));
+      if (digit < 0) {
+        break;
+      }
+      foundDigit = true;
+      if (result > smax) {
+        overflow = true;
+      } else {
+        result *= 16;
+        overflow |= result > max - digit;
+        result += digit;
+      }
+      c = buf->snextc();
+    }
+
+    std::ios::iostate state = std::ios::goodbit;
+    if (!foundDigit && !foundZero) {
+      hex.ref = 0;
+      state |= std::ios::failbit;
+    } else if (overflow) {
+      hex.ref = max;
+      state |= std::ios::failbit;
+    } else {
+      hex.ref = negative ? -result : result;
+    }
+    if (traits::eq_int_type(c, traits::eof())) {
+      state |= std::ios::eofbit;
+    }
+    in.setstate(state);
+    return in;
   }
 
   std::istream& operator>>(std::istream& in, StringI&& str)
@@ -119,7 +198,7 @@ namespace dribas
     }
     StreamGuard guard(in);
 
-    DataStruct temp;
+    DataStruct temp{};
     in >> DelimiterI{ '(' } >> DelimiterI{ ':' };
 
     bool hasKey1 = false, hasKey2 = false, hasKey3 = false;
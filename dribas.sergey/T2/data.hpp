@@ -17,6 +17,11 @@ namespace dribas
     unsigned long long& ref;
   };
 
+  struct HexI
+  {
+    unsigned long long& ref;
+  };
+
   struct DoubleI
   {
     double& ref;
@@ -52,6 +57,7 @@ namespace dribas
   std::istream& operator>>(std::istream&, DataStruct&);
   std::istream& operator>>(std::istream&, DoubleI&&);
   std::istream& operator>>(std::istream&, UllI&&);
+  std::istream& operator>>(std::istream&, HexI&&);
   std::istream& operator>>(std::istream&, StringI&&);
   std::istream& operator>>(std::istream&, KeyI&&);
 
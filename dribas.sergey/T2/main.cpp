@@ -3,15 +3,36 @@
 #include <limits>
 #include <iterator>
 #include <iostream>
+#include <string>
 
 #include "data.hpp"
+#include "pipeline.hpp"
 
-int main()
+int main(int argc, char* argv[])
 {
   using namespace dribas;
   using ositer = std::ostream_iterator< DataStruct >;
   using isiter = std::istream_iterator< DataStruct >;
 
+  size_t jobs = 1;
+  if (argc == 3 && std::string(argv[1]) == "--jobs") {
+    try {
+      jobs = std::stoull(argv[2]);
+    } catch (const std::exception&) {
+      jobs = 0;
+    }
+  } else if (argc != 1) {
+    jobs = 0;
+  }
+  if (jobs == 0) {
+    std::cerr << "Usage: lab [--jobs N]" << '\n';
+    return 1;
+  }
+
+  if (jobs > 1) {
+    runPipeline(std::cin, std::cout, jobs);
+    return 0;
+  }
 
   std::vector< DataStruct > data;
 
@@ -23,7 +44,7 @@ int main()
     }
   }
 
-  std::sort(data.begin(), data.end(), compare);
+  std::stable_sort(data.begin(), data.end(), compare);
   std::copy(data.begin(), data.end(), ositer(std::cout, "\n"));
 
   return 0;
@@ -0,0 +1,266 @@
+#include "pipeline.hpp"
+
+#include <algorithm>
+#include <future>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "data.hpp"
+
+namespace
+{
+  using dribas::DataStruct;
+  using Records = std::vector< DataStruct >;
+
+  constexpr size_t READ_BLOCK = 1 << 20;
+  constexpr size_t MIN_CHUNK = 1 << 16;
+  constexpr size_t OUTPUT_SLICE = 1 << 14;
+
+  class MemoryBuf: public std::streambuf
+  {
+  public:
+    MemoryBuf(char* begin, char* end, size_t start)
+    {
+      setg(begin, begin + start, end);
+    }
+
+    size_t position() const
+    {
+      return gptr() - eback();
+    }
+  };
+
+  struct Chunk
+  {
+    size_t end = 0;
+    size_t stop = 0;
+    bool eof = false;
+    Records records;
+    std::vector< size_t > starts;
+    std::vector< size_t > counts;
+  };
+
+  std::string readAll(std::istream& in)
+  {
+    std::string input;
+    std::streambuf* buf = in.rdbuf();
+    std::streamsize got = 0;
+    do {
+      size_t old = input.size();
+      input.resize(old + READ_BLOCK);
+      got = buf->sgetn(&input[old], READ_BLOCK);
+      input.resize(old + got);
+    } while (got > 0);
+    return input;
+  }
+
+  std::vector< size_t > splitLines(const std::string& input, size_t jobs)
+  {
+    size_t target = std::max(MIN_CHUNK, input.size() / jobs + 1);
+    std::vector< size_t > bounds{ 0 };
+    while (bounds.back() < input.size()) {
+      size_t next = bounds.back() + target;
+      if (next >= input.size()) {
+        bounds.push_back(input.size());
+      } else {
+        size_t eol = input.find('\n', next);
+        bounds.push_back(eol == std::string::npos ? input.size() : eol + 1);
+      }
+    }
+    return bounds;
+  }
+
+  Chunk parseRange(char* data, size_t size, size_t from, size_t until)
+  {
+    Chunk chunk;
+    chunk.end = until;
+    MemoryBuf buf(data, data + size, from);
+    std::istream in(&buf);
+    while (!in.eof() && buf.position() < until) {
+      chunk.starts.push_back(buf.position());
+      chunk.counts.push_back(chunk.records.size());
+      DataStruct record;
+      if (in >> record) {
+        chunk.records.push_back(std::move(record));
+      } else {
+        in.clear();
+        in.ignore(std::numeric_limits< std::streamsize >::max(), '\n');
+      }
+    }
+    chunk.stop = buf.position();
+    chunk.eof = in.eof() || chunk.stop >= size;
+    return chunk;
+  }
+
+  std::vector< Records > parseChunks(std::string& input, size_t jobs)
+  {
+    std::vector< size_t > bounds = splitLines(input, jobs);
+    char* data = &input[0];
+    std::vector< std::future< Chunk > > parsed;
+    for (size_t i = 0; i + 1 < bounds.size(); ++i) {
+      parsed.push_back(std::async(std::launch::async, parseRange, data, input.size(), bounds[i], bounds[i + 1]));
+    }
+
+    std::vector< Records > runs;
+    size_t pos = 0;
+    bool eof = false;
+    for (size_t i = 0; i < parsed.size(); ++i) {
+      Chunk chunk = parsed[i].get();
+      if (eof || pos >= chunk.end) {
+        continue;
+      }
+      auto start = std::lower_bound(chunk.starts.begin(), chunk.starts.end(), pos);
+      if (start == chunk.starts.end() || *start != pos) {
+        chunk = parseRange(data, input.size(), pos, chunk.end);
+      } else {
+        size_t skipped = chunk.counts[start - chunk.starts.begin()];
+        chunk.records.erase(chunk.records.begin(), chunk.records.begin() + skipped);
+      }
+      pos = chunk.stop;
+      eof = chunk.eof;
+      runs.push_back(std::move(chunk.records));
+    }
+    return runs;
+  }
+
+  void sortRun(Records& run)
+  {
+    std::stable_sort(run.begin(), run.end(), dribas::compare);
+  }
+
+  size_t coRank(const Records& lhs, const Records& rhs, size_t k)
+  {
+    size_t low = k > rhs.size() ? k - rhs.size() : 0;
+    size_t high = std::min(k, lhs.size());
+    while (low < high) {
+      size_t i = low + (high - low) / 2;
+      size_t j = k - i;
+      if (j > 0 && !dribas::compare(rhs[j - 1], lhs[i])) {
+        low = i + 1;
+      } else {
+        high = i;
+      }
+    }
+    return low;
+  }
+
+  struct MergeSlice
+  {
+    size_t lhsFrom = 0;
+    size_t lhsTo = 0;
+    size_t rhsFrom = 0;
+    size_t rhsTo = 0;
+  };
+
+  void mergeSlice(Records& lhs, Records& rhs, Records& out, MergeSlice slice)
+  {
+    std::merge(
+      std::make_move_iterator(lhs.begin() + slice.lhsFrom), std::make_move_iterator(lhs.begin() + slice.lhsTo),
+      std::make_move_iterator(rhs.begin() + slice.rhsFrom), std::make_move_iterator(rhs.begin() + slice.rhsTo),
+      out.begin() + slice.lhsFrom + slice.rhsFrom, dribas::compare
+    );
+  }
+
+  Records mergeRuns(std::vector< Records >& runs, size_t jobs)
+  {
+    while (runs.size() > 1) {
+      size_t pairs = runs.size() / 2;
+      size_t parts = std::max< size_t >(1, jobs / pairs);
+      std::vector< Records > merged(pairs);
+      std::vector< std::vector< MergeSlice > > slices(pairs);
+      for (size_t p = 0; p < pairs; ++p) {
+        const Records& lhs = runs[2 * p];
+        const Records& rhs = runs[2 * p + 1];
+        size_t total = lhs.size() + rhs.size();
+        merged[p].resize(total);
+        size_t split = 0;
+        for (size_t part = 0; part < parts; ++part) {
+          size_t from = total * part / parts;
+          size_t to = total * (part + 1) / parts;
+          size_t next = coRank(lhs, rhs, to);
+          slices[p].push_back(MergeSlice{ split, next, from - split, to - next });
+          split = next;
+        }
+      }
+      std::vector< std::future< void > > tasks;
+      for (size_t p = 0; p < pairs; ++p) {
+        for (auto&& slice: slices[p]) {
+          tasks.push_back(std::async(std::launch::async, mergeSlice, std::ref(runs[2 * p]), std::ref(runs[2 * p + 1]), std::ref(merged[p]), slice));
+        }
+      }
+      for (auto&& task: tasks) {
+        task.get();
+      }
+      if (runs.size() % 2) {
+        merged.push_back(std::move(runs.back()));
+      }
+      runs = std::move(merged);
+    }
+    return runs.empty() ? Records() : std::move(runs.front());
+  }
+
+  std::string formatSlice(const Records& data, size_t from, size_t to)
+  {
+    std::ostringstream out;
+    std::copy(data.begin() + from, data.begin() + to, std::ostream_iterator< DataStruct >(out, "\n"));
+    return out.str();
+  }
+
+  void formatSlices(const Records& data, std::vector< std::promise< std::string > >& slices, size_t first, size_t step)
+  {
+    for (size_t i = first; i < slices.size(); i += step) {
+      try {
+        size_t from = i * OUTPUT_SLICE;
+        slices[i].set_value(formatSlice(data, from, std::min(data.size(), from + OUTPUT_SLICE)));
+      } catch (...) {
+        slices[i].set_exception(std::current_exception());
+      }
+    }
+  }
+
+  void writeSlices(std::ostream& out, std::vector< std::future< std::string > >& slices)
+  {
+    for (auto&& slice: slices) {
+      out << slice.get();
+    }
+  }
+
+  void writeSorted(std::ostream& out, const Records& data, size_t jobs)
+  {
+    size_t count = (data.size() + OUTPUT_SLICE - 1) / OUTPUT_SLICE;
+    std::vector< std::promise< std::string > > slices(count);
+    std::vector< std::future< std::string > > formatted;
+    for (auto&& slice: slices) {
+      formatted.push_back(slice.get_future());
+    }
+    auto writer = std::async(std::launch::async, writeSlices, std::ref(out), std::ref(formatted));
+    size_t workers = std::max< size_t >(1, std::min(jobs, count));
+    std::vector< std::future< void > > formatters;
+    for (size_t i = 0; i < workers; ++i) {
+      formatters.push_back(std::async(std::launch::async, formatSlices, std::cref(data), std::ref(slices), i, workers));
+    }
+    for (auto&& formatter: formatters) {
+      formatter.get();
+    }
+    writer.get();
+  }
+}
+
+void dribas::runPipeline(std::istream& in, std::ostream& out, size_t jobs)
+{
+  std::string input = readAll(in);
+  std::vector< Records > runs = parseChunks(input, jobs);
+  std::vector< std::future< void > > sorts;
+  for (auto&& run: runs) {
+    sorts.push_back(std::async(std::launch::async, sortRun, std::ref(run)));
+  }
+  for (auto&& sort: sorts) {
+    sort.get();
+  }
+  Records data = mergeRuns(runs, jobs);
+  writeSorted(out, data, jobs);
+}
@@ -0,0 +1,12 @@
+#ifndef PIPELINE_HPP
+#define PIPELINE_HPP
+
+#include <cstddef>
+#include <iosfwd>
+
+namespace dribas
+{
+  void runPipeline(std::istream&, std::ostream&, size_t jobs);
+}
+
+#endif
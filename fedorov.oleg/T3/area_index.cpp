@@ -0,0 +1,53 @@
+#include "area_index.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include "functional.hpp"
+
+namespace fedorov
+{
+  AreaIndex::AreaIndex(const std::vector< Polygon > &polygons):
+    areas()
+  {
+    areas.reserve(polygons.size());
+    std::transform(polygons.begin(), polygons.end(), std::back_inserter(areas), calcPolygonArea);
+    std::sort(areas.begin(), areas.end());
+  }
+
+  void AreaIndex::insert(double area, size_t count)
+  {
+    auto pos = std::upper_bound(areas.begin(), areas.end(), area);
+    areas.insert(pos, count, area);
+  }
+
+  size_t AreaIndex::countLess(double area) const
+  {
+    return std::lower_bound(areas.begin(), areas.end(), area) - areas.begin();
+  }
+
+  size_t AreaIndex::countInRange(double low, double high) const
+  {
+    if (high < low)
+    {
+      return 0;
+    }
+    auto first = std::lower_bound(areas.begin(), areas.end(), low);
+    auto last = std::upper_bound(first, areas.end(), high);
+    return last - first;
+  }
+
+  double AreaIndex::kth(size_t k) const
+  {
+    if (k == 0 || k > areas.size())
+    {
+      throw std::out_of_range("Area rank out of range");
+    }
+    return areas[k - 1];
+  }
+
+  size_t AreaIndex::size() const
+  {
+    return areas.size();
+  }
+}
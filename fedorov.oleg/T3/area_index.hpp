@@ -0,0 +1,24 @@
+#ifndef AREA_INDEX_HPP
+#define AREA_INDEX_HPP
+
+#include <vector>
+#include "polygon.hpp"
+
+namespace fedorov
+{
+  class AreaIndex
+  {
+  public:
+    explicit AreaIndex(const std::vector< Polygon > &polygons);
+    void insert(double area, size_t count = 1);
+    size_t countLess(double area) const;
+    size_t countInRange(double low, double high) const;
+    double kth(size_t k) const;
+    size_t size() const;
+
+  private:
+    std::vector< double > areas;
+  };
+}
+
+#endif
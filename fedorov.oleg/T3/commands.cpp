@@ -236,7 +236,7 @@ namespace fedorov
     }
   }
 
-  void lessAreaCommand(std::istream &in, std::ostream &out, const std::vector< Polygon > &polygons)
+  void lessAreaCommand(std::istream &in, std::ostream &out, const AreaIndex &index)
   {
     Polygon target;
     if (!(in >> target) || !validatePolygon(target))
@@ -244,12 +244,33 @@ namespace fedorov
       throw std::invalid_argument("Invalid polygon");
     }
 
-    double threshold = calcPolygonArea(target);
-    auto calcAreaLess = std::bind(std::less< double >{}, std::bind(calcPolygonArea, _1), threshold);
-    out << std::count_if(polygons.begin(), polygons.end(), calcAreaLess) << '\n';
+    out << index.countLess(calcPolygonArea(target)) << '\n';
   }
 
-  void echoCommand(std::istream &in, std::ostream &out, std::vector< Polygon > &polygons)
+  void areaRangeCommand(std::istream &in, std::ostream &out, const AreaIndex &index)
+  {
+    double low = 0.0;
+    double high = 0.0;
+    if (!(in >> low >> high) || low < 0.0)
+    {
+      throw std::invalid_argument("Invalid area range");
+    }
+
+    out << index.countInRange(low, high) << '\n';
+  }
+
+  void kthAreaCommand(std::istream &in, std::ostream &out, const AreaIndex &index)
+  {
+    size_t k = 0;
+    if (!(in >> k))
+    {
+      throw std::invalid_argument("Invalid area rank");
+    }
+
+    outputArea(index.kth(k), out);
+  }
+
+  void echoCommand(std::istream &in, std::ostream &out, std::vector< Polygon > &polygons, AreaIndex &index)
   {
     Polygon target;
     if (!(in >> target) || !validatePolygon(target))
@@ -268,6 +289,7 @@ namespace fedorov
     std::copy_if(polygons.begin(), polygons.end(), std::back_inserter(result), polygonEqT);
 
     polygons.swap(result);
+    index.insert(calcPolygonArea(target), count);
     out << count << '\n';
   }
 }
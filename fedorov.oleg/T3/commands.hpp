@@ -4,6 +4,7 @@
 #include <iostream>
 #include <vector>
 #include "polygon.hpp"
+#include "area_index.hpp"
 
 namespace fedorov
 {
@@ -38,8 +39,10 @@ namespace fedorov
   void maxCommand(std::istream &in, std::ostream &out, const std::vector< Polygon > &polys);
   void minCommand(std::istream &in, std::ostream &out, const std::vector< Polygon > &polys);
   void countCommand(std::istream &in, std::ostream &out, const std::vector< Polygon > &polygons);
-  void lessAreaCommand(std::istream &in, std::ostream &out, const std::vector< Polygon > &polygons);
-  void echoCommand(std::istream &in, std::ostream &out, std::vector< Polygon > &polygons);
+  void lessAreaCommand(std::istream &in, std::ostream &out, const AreaIndex &index);
+  void areaRangeCommand(std::istream &in, std::ostream &out, const AreaIndex &index);
+  void kthAreaCommand(std::istream &in, std::ostream &out, const AreaIndex &index);
+  void echoCommand(std::istream &in, std::ostream &out, std::vector< Polygon > &polygons, AreaIndex &index);
 }
 
 #endif
@@ -6,6 +6,7 @@
 #include <limits>
 #include "polygon.hpp"
 #include "commands.hpp"
+#include "area_index.hpp"
 #include "functional.hpp"
 
 int main(int argc, char *argv[])
@@ -38,13 +39,17 @@ int main(int argc, char *argv[])
     return 3;
   }
 
+  AreaIndex areaIndex(polygons);
+
   std::map< std::string, std::function< void(std::istream &, std::ostream &) > > commands;
   commands["AREA"] = std::bind(areaCommand, _1, _2, std::cref(polygons));
   commands["MAX"] = std::bind(maxCommand, _1, _2, std::cref(polygons));
   commands["MIN"] = std::bind(minCommand, _1, _2, std::cref(polygons));
   commands["COUNT"] = std::bind(countCommand, _1, _2, std::cref(polygons));
-  commands["LESSAREA"] = std::bind(lessAreaCommand, _1, _2, std::cref(polygons));
-  commands["ECHO"] = std::bind(echoCommand, _1, _2, std::ref(polygons));
+  commands["LESSAREA"] = std::bind(lessAreaCommand, _1, _2, std::cref(areaIndex));
+  commands["AREARANGE"] = std::bind(areaRangeCommand, _1, _2, std::cref(areaIndex));
+  commands["KTHAREA"] = std::bind(kthAreaCommand, _1, _2, std::cref(areaIndex));
+  commands["ECHO"] = std::bind(echoCommand, _1, _2, std::ref(polygons), std::ref(areaIndex));
 
   std::string command;
   while (std::cin >> command)
@@ -3,32 +3,70 @@
 #include <iomanip>
 #include "format_guard.hpp"
 
-void filonova::area(std::istream &in, std::ostream &out, const std::vector< Polygon > &polygons)
+namespace
+{
+  bool hasEvenVertexes(const filonova::ShapeInfo &shape)
+  {
+    return filonova::hasFlags(shape, filonova::HAS_EVEN_VERTEXES);
+  }
+
+  bool hasOddVertexes(const filonova::ShapeInfo &shape)
+  {
+    return !hasEvenVertexes(shape);
+  }
+
+  double addArea(double sum, const filonova::ShapeInfo &shape)
+  {
+    return sum + shape.area;
+  }
+
+  double sumAreas(const std::vector< filonova::ShapeInfo > &shapes)
+  {
+    return std::accumulate(shapes.begin(), shapes.end(), 0.0, addArea);
+  }
+
+  bool compareShapesByArea(const filonova::ShapeInfo &a, const filonova::ShapeInfo &b)
+  {
+    return a.area < b.area;
+  }
+
+  bool compareShapesByVertexes(const filonova::ShapeInfo &a, const filonova::ShapeInfo &b)
+  {
+    return a.vertexes < b.vertexes;
+  }
+
+  bool intersectsWith(const filonova::Frame &frame, const filonova::ShapeInfo &shape)
+  {
+    return filonova::overlaps(frame, shape.frame);
+  }
+}
+
+void filonova::area(std::istream &in, std::ostream &out, const std::vector< ShapeInfo > &shapes)
 {
   filonova::FormatGuard guard(out);
 
   std::string subcmd;
   in >> subcmd;
 
-  std::vector< Polygon > filteredPolygons;
+  std::vector< ShapeInfo > filteredShapes;
 
   if (subcmd == "EVEN")
   {
-    std::copy_if(polygons.begin(), polygons.end(), std::back_inserter(filteredPolygons), isEven);
+    std::copy_if(shapes.begin(), shapes.end(), std::back_inserter(filteredShapes), hasEvenVertexes);
   }
   else if (subcmd == "ODD")
   {
-    std::copy_if(polygons.begin(), polygons.end(), std::back_inserter(filteredPolygons), isOdd);
+    std::copy_if(shapes.begin(), shapes.end(), std::back_inserter(filteredShapes), hasOddVertexes);
   }
   else if (subcmd == "MEAN")
   {
-    if (polygons.empty())
+    if (shapes.empty())
     {
       throw std::logic_error("<INVALID COMMAND>");
     }
 
-    double totalArea = getTotalArea(polygons);
-    out << std::fixed << std::setprecision(1) << totalArea / polygons.size();
+    double totalArea = sumAreas(shapes);
+    out << std::fixed << std::setprecision(1) << totalArea / shapes.size();
     return;
   }
   else if (std::all_of(subcmd.begin(), subcmd.end(), ::isdigit))
@@ -40,23 +78,23 @@ void filonova::area(std::istream &in, std::ostream &out, const std::vector< Poly
     }
 
     auto pred = std::bind(filonova::hasVertexCount, std::placeholders::_1, vertexCount);
-    std::copy_if(polygons.begin(), polygons.end(), std::back_inserter(filteredPolygons), pred);
+    std::copy_if(shapes.begin(), shapes.end(), std::back_inserter(filteredShapes), pred);
   }
   else
   {
     throw std::logic_error("<INVALID COMMAND>");
   }
 
-  double totalArea = getTotalArea(filteredPolygons);
+  double totalArea = sumAreas(filteredShapes);
   out << std::fixed << std::setprecision(1) << totalArea;
 }
 
-bool filonova::hasVertexCount(const filonova::Polygon &p, size_t count)
+bool filonova::hasVertexCount(const filonova::ShapeInfo &shape, size_t count)
 {
-  return p.points.size() == count;
+  return shape.vertexes == count;
 }
 
-void filonova::max(std::istream &in, std::ostream &out, const std::vector< Polygon > &polygons)
+void filonova::max(std::istream &in, std::ostream &out, const std::vector< ShapeInfo > &shapes)
 {
   filonova::FormatGuard guard(out);
 
@@ -65,20 +103,20 @@ void filonova::max(std::istream &in, std::ostream &out, const std::vector< Polyg
 
   out << std::fixed << std::setprecision(1);
 
-  if (polygons.empty())
+  if (shapes.empty())
   {
     throw std::logic_error("<INVALID COMMAND>");
   }
 
   if (subcmd == "AREA")
   {
-    auto maxIt = std::max_element(polygons.begin(), polygons.end(), compareByArea);
-    out << getPolygonArea(*maxIt);
+    auto maxIt = std::max_element(shapes.begin(), shapes.end(), compareShapesByArea);
+    out << maxIt->area;
   }
   else if (subcmd == "VERTEXES")
   {
-    auto maxIt = std::max_element(polygons.begin(), polygons.end(), compareByVertexes);
-    out << maxIt->points.size();
+    auto maxIt = std::max_element(shapes.begin(), shapes.end(), compareShapesByVertexes);
+    out << maxIt->vertexes;
   }
   else
   {
@@ -86,7 +124,7 @@ void filonova::max(std::istream &in, std::ostream &out, const std::vector< Polyg
   }
 }
 
-void filonova::min(std::istream &in, std::ostream &out, const std::vector< Polygon > &polygons)
+void filonova::min(std::istream &in, std::ostream &out, const std::vector< ShapeInfo > &shapes)
 {
   filonova::FormatGuard guard(out);
 
@@ -95,20 +133,20 @@ void filonova::min(std::istream &in, std::ostream &out, const std::vector< Polyg
 
   out << std::fixed << std::setprecision(1);
 
-  if (polygons.empty())
+  if (shapes.empty())
   {
     throw std::logic_error("<INVALID COMMAND>");
   }
 
   if (subcmd == "AREA")
   {
-    auto minIt = std::min_element(polygons.begin(), polygons.end(), compareByArea);
-    out << getPolygonArea(*minIt);
+    auto minIt = std::min_element(shapes.begin(), shapes.end(), compareShapesByArea);
+    out << minIt->area;
   }
   else if (subcmd == "VERTEXES")
   {
-    auto minIt = std::min_element(polygons.begin(), polygons.end(), compareByVertexes);
-    out << minIt->points.size();
+    auto minIt = std::min_element(shapes.begin(), shapes.end(), compareShapesByVertexes);
+    out << minIt->vertexes;
   }
   else
   {
@@ -116,7 +154,7 @@ void filonova::min(std::istream &in, std::ostream &out, const std::vector< Polyg
   }
 }
 
-void filonova::count(std::istream &in, std::ostream &out, const std::vector< Polygon > &polygons)
+void filonova::count(std::istream &in, std::ostream &out, const std::vector< ShapeInfo > &shapes)
 {
   std::string subcmd;
   in >> subcmd;
@@ -125,11 +163,11 @@ void filonova::count(std::istream &in, std::ostream &out, const std::vector< Pol
 
   if (subcmd == "EVEN")
   {
-    count = std::count_if(polygons.begin(), polygons.end(), isEven);
+    count = countFlags(shapes, HAS_EVEN_VERTEXES);
   }
   else if (subcmd == "ODD")
   {
-    count = std::count_if(polygons.begin(), polygons.end(), isOdd);
+    count = shapes.size() - countFlags(shapes, HAS_EVEN_VERTEXES);
   }
   else if (std::all_of(subcmd.begin(), subcmd.end(), ::isdigit))
   {
@@ -140,7 +178,7 @@ void filonova::count(std::istream &in, std::ostream &out, const std::vector< Pol
     }
 
     auto pred = std::bind(hasVertexCount, std::placeholders::_1, vertexCount);
-    count = std::count_if(polygons.begin(), polygons.end(), pred);
+    count = std::count_if(shapes.begin(), shapes.end(), pred);
   }
   else
   {
@@ -150,25 +188,7 @@ void filonova::count(std::istream &in, std::ostream &out, const std::vector< Pol
   out << count;
 }
 
-bool intersectsWith(const filonova::Polygon &a, const filonova::Polygon &b)
-{
-  int p1_minX = std::min_element(a.points.cbegin(), a.points.cend(), filonova::comparePointByX)->x;
-  int p1_maxX = std::max_element(a.points.cbegin(), a.points.cend(), filonova::comparePointByX)->x;
-  int p1_minY = std::min_element(a.points.cbegin(), a.points.cend(), filonova::comparePointByY)->y;
-  int p1_maxY = std::max_element(a.points.cbegin(), a.points.cend(), filonova::comparePointByY)->y;
-
-  int p2_minX = std::min_element(b.points.cbegin(), b.points.cend(), filonova::comparePointByX)->x;
-  int p2_maxX = std::max_element(b.points.cbegin(), b.points.cend(), filonova::comparePointByX)->x;
-  int p2_minY = std::min_element(b.points.cbegin(), b.points.cend(), filonova::comparePointByY)->y;
-  int p2_maxY = std::max_element(b.points.cbegin(), b.points.cend(), filonova::comparePointByY)->y;
-
-  bool x_overlap = (p1_minX <= p2_maxX) && (p2_minX <= p1_maxX);
-  bool y_overlap = (p1_minY <= p2_maxY) && (p2_minY <= p1_maxY);
-
-  return x_overlap && y_overlap;
-}
-
-void filonova::intersections(std::istream &in, std::ostream &out, const std::vector< Polygon > &polygons)
+void filonova::intersections(std::istream &in, std::ostream &out, const std::vector< ShapeInfo > &shapes)
 {
   Polygon polygon;
   in >> polygon;
@@ -178,55 +198,11 @@ void filonova::intersections(std::istream &in, std::ostream &out, const std::vec
     throw std::logic_error("<INVALID COMMAND>");
   }
 
-  out << std::count_if(polygons.cbegin(), polygons.cend(), std::bind(intersectsWith, polygon, std::placeholders::_1));
+  Frame frame = getFrame(polygon);
+  out << std::count_if(shapes.cbegin(), shapes.cend(), std::bind(intersectsWith, std::cref(frame), std::placeholders::_1));
 }
 
-void filonova::rects(std::ostream &out, const std::vector< Polygon > &polygons)
+void filonova::rects(std::ostream &out, const std::vector< ShapeInfo > &shapes)
 {
-  size_t count = std::count_if(polygons.begin(), polygons.end(), isRectangle);
-  out << count;
-}
-
-double dot(const filonova::Point &a, const filonova::Point &b, const filonova::Point &c)
-{
-  double abx = b.x - a.x;
-  double aby = b.y - a.y;
-  double bcx = c.x - b.x;
-  double bcy = c.y - b.y;
-  return abx * bcx + aby * bcy;
-}
-
-double getDistanceSquared(const filonova::Point &a, const filonova::Point &b)
-{
-  double dx = b.x - a.x;
-  double dy = b.y - a.y;
-  return dx * dx + dy * dy;
-}
-
-bool isRightAngle(const filonova::Point &prev, const filonova::Point &current, const filonova::Point &next)
-{
-  return std::abs(dot(prev, current, next)) <= EPS;
-}
-
-bool filonova::isRectangle(const filonova::Polygon &polygon)
-{
-  const auto &points = polygon.points;
-
-  if (points.size() != RECTANGLE_SIDES)
-  {
-    return false;
-  }
-
-  double diag1 = getDistanceSquared(points[0], points[2]);
-  double diag2 = getDistanceSquared(points[1], points[3]);
-
-  if (std::abs(diag1 - diag2) > EPS)
-  {
-    return false;
-  }
-
-  return isRightAngle(points[3], points[0], points[1]) &&
-    isRightAngle(points[0], points[1], points[2]) &&
-    isRightAngle(points[1], points[2], points[3]) &&
-    isRightAngle(points[2], points[3], points[0]);
+  out << countFlags(shapes, IS_RECTANGLE);
 }
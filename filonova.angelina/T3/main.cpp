@@ -38,15 +38,17 @@ int main(int argc, char *argv[])
       }
     }
 
+    std::vector< ShapeInfo > shapes = classifyAll(polygons);
+
     std::map< std::string, std::function< void(std::istream &, std::ostream &) > > cmds;
     {
       using namespace std::placeholders;
-      cmds["AREA"] = std::bind(area, _1, _2, std::cref(polygons));
-      cmds["MAX"] = std::bind(max, _1, _2, std::cref(polygons));
-      cmds["MIN"] = std::bind(min, _1, _2, std::cref(polygons));
-      cmds["COUNT"] = std::bind(count, _1, _2, std::cref(polygons));
-      cmds["INTERSECTIONS"] = std::bind(intersections, _1, _2, std::cref(polygons));
-      cmds["RECTS"] = std::bind(rects, _2, std::cref(polygons));
+      cmds["AREA"] = std::bind(area, _1, _2, std::cref(shapes));
+      cmds["MAX"] = std::bind(max, _1, _2, std::cref(shapes));
+      cmds["MIN"] = std::bind(min, _1, _2, std::cref(shapes));
+      cmds["COUNT"] = std::bind(count, _1, _2, std::cref(shapes));
+      cmds["INTERSECTIONS"] = std::bind(intersections, _1, _2, std::cref(shapes));
+      cmds["RECTS"] = std::bind(rects, _2, std::cref(shapes));
 
       std::string command;
       while (std::cin >> command)
@@ -0,0 +1,192 @@
+#include "shape_info.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  double dot(const filonova::Point &a, const filonova::Point &b, const filonova::Point &c)
+  {
+    double abx = b.x - a.x;
+    double aby = b.y - a.y;
+    double bcx = c.x - b.x;
+    double bcy = c.y - b.y;
+    return abx * bcx + aby * bcy;
+  }
+
+  double cross(const filonova::Point &a, const filonova::Point &b, const filonova::Point &c)
+  {
+    double abx = b.x - a.x;
+    double aby = b.y - a.y;
+    double bcx = c.x - b.x;
+    double bcy = c.y - b.y;
+    return abx * bcy - aby * bcx;
+  }
+
+  double getDistanceSquared(const filonova::Point &a, const filonova::Point &b)
+  {
+    double dx = b.x - a.x;
+    double dy = b.y - a.y;
+    return dx * dx + dy * dy;
+  }
+
+  bool isRightAngle(const filonova::Point &prev, const filonova::Point &current, const filonova::Point &next)
+  {
+    return std::abs(dot(prev, current, next)) <= EPS;
+  }
+
+  bool hasRightAngle(const filonova::Polygon &polygon)
+  {
+    const auto &points = polygon.points;
+    size_t n = points.size();
+    for (size_t i = 0; i < n; ++i)
+    {
+      if (isRightAngle(points[(i + n - 1) % n], points[i], points[(i + 1) % n]))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool isConvex(const filonova::Polygon &polygon)
+  {
+    const auto &points = polygon.points;
+    size_t n = points.size();
+    bool hasPositive = false;
+    bool hasNegative = false;
+    for (size_t i = 0; i < n; ++i)
+    {
+      double turn = cross(points[i], points[(i + 1) % n], points[(i + 2) % n]);
+      hasPositive = hasPositive || turn > EPS;
+      hasNegative = hasNegative || turn < -EPS;
+    }
+    return !(hasPositive && hasNegative);
+  }
+
+  bool isSquare(const filonova::Polygon &polygon)
+  {
+    const auto &points = polygon.points;
+    return std::abs(getDistanceSquared(points[0], points[1]) - getDistanceSquared(points[1], points[2])) <= EPS;
+  }
+
+  struct ClassifyChunk
+  {
+    const std::vector< filonova::Polygon > &polygons;
+    std::vector< filonova::ShapeInfo > &shapes;
+    size_t first, last;
+    void operator()() const
+    {
+      std::transform(polygons.begin() + first, polygons.begin() + last, shapes.begin() + first, filonova::classify);
+    }
+  };
+
+  struct FlagsMatch
+  {
+    unsigned char mask;
+    bool operator()(const filonova::ShapeInfo &shape) const
+    {
+      return filonova::hasFlags(shape, mask);
+    }
+  };
+}
+
+filonova::Frame filonova::getFrame(const Polygon &polygon)
+{
+  const auto &points = polygon.points;
+  Frame frame{0, 0, 0, 0};
+  frame.minX = std::min_element(points.cbegin(), points.cend(), comparePointByX)->x;
+  frame.maxX = std::max_element(points.cbegin(), points.cend(), comparePointByX)->x;
+  frame.minY = std::min_element(points.cbegin(), points.cend(), comparePointByY)->y;
+  frame.maxY = std::max_element(points.cbegin(), points.cend(), comparePointByY)->y;
+  return frame;
+}
+
+bool filonova::overlaps(const Frame &a, const Frame &b)
+{
+  bool x_overlap = (a.minX <= b.maxX) && (b.minX <= a.maxX);
+  bool y_overlap = (a.minY <= b.maxY) && (b.minY <= a.maxY);
+  return x_overlap && y_overlap;
+}
+
+bool filonova::isRectangle(const filonova::Polygon &polygon)
+{
+  const auto &points = polygon.points;
+
+  if (points.size() != RECTANGLE_SIDES)
+  {
+    return false;
+  }
+
+  double diag1 = getDistanceSquared(points[0], points[2]);
+  double diag2 = getDistanceSquared(points[1], points[3]);
+
+  if (std::abs(diag1 - diag2) > EPS)
+  {
+    return false;
+  }
+
+  return isRightAngle(points[3], points[0], points[1]) &&
+    isRightAngle(points[0], points[1], points[2]) &&
+    isRightAngle(points[1], points[2], points[3]) &&
+    isRightAngle(points[2], points[3], points[0]);
+}
+
+filonova::ShapeInfo filonova::classify(const Polygon &polygon)
+{
+  ShapeInfo shape{getPolygonArea(polygon), getFrame(polygon), polygon.points.size(), 0};
+  if (isRectangle(polygon))
+  {
+    shape.flags |= IS_RECTANGLE;
+    shape.flags |= isSquare(polygon) ? IS_SQUARE : 0;
+  }
+  shape.flags |= hasRightAngle(polygon) ? HAS_RIGHT_ANGLE : 0;
+  shape.flags |= isConvex(polygon) ? IS_CONVEX : 0;
+  shape.flags |= isEven(polygon) ? HAS_EVEN_VERTEXES : 0;
+  return shape;
+}
+
+std::vector< filonova::ShapeInfo > filonova::classifyAll(const std::vector< Polygon > &polygons)
+{
+  std::vector< ShapeInfo > shapes(polygons.size());
+  size_t chunks = std::min< size_t >(std::thread::hardware_concurrency(), polygons.size() / MIN_PARALLEL_CHUNK);
+  if (chunks < 2)
+  {
+    ClassifyChunk{polygons, shapes, 0, polygons.size()}();
+    return shapes;
+  }
+
+  size_t chunkSize = (polygons.size() + chunks - 1) / chunks;
+  std::vector< std::thread > workers;
+  workers.reserve(chunks - 1);
+  try
+  {
+    for (size_t i = 1; i < chunks; ++i)
+    {
+      size_t first = i * chunkSize;
+      size_t last = std::min(first + chunkSize, polygons.size());
+      workers.emplace_back(ClassifyChunk{polygons, shapes, first, last});
+    }
+    ClassifyChunk{polygons, shapes, 0, chunkSize}();
+  }
+  catch (...)
+  {
+    std::for_each(workers.begin(), workers.end(), std::mem_fn(&std::thread::join));
+    throw;
+  }
+  std::for_each(workers.begin(), workers.end(), std::mem_fn(&std::thread::join));
+  return shapes;
+}
+
+bool filonova::hasFlags(const ShapeInfo &shape, unsigned char mask)
+{
+  return (shape.flags & mask) == mask;
+}
+
+size_t filonova::countFlags(const std::vector< ShapeInfo > &shapes, unsigned char mask)
+{
+  return std::count_if(shapes.begin(), shapes.end(), FlagsMatch{mask});
+}
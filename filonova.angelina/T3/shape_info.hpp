@@ -0,0 +1,43 @@
+#ifndef SHAPE_INFO_HPP
+#define SHAPE_INFO_HPP
+
+#include "polygon.hpp"
+
+#include <vector>
+
+constexpr size_t RECTANGLE_SIDES = 4;
+constexpr double EPS = 1e-9;
+constexpr size_t MIN_PARALLEL_CHUNK = 4096;
+
+namespace filonova
+{
+  constexpr unsigned char IS_RECTANGLE = 0x01;
+  constexpr unsigned char IS_SQUARE = 0x02;
+  constexpr unsigned char HAS_RIGHT_ANGLE = 0x04;
+  constexpr unsigned char IS_CONVEX = 0x08;
+  constexpr unsigned char HAS_EVEN_VERTEXES = 0x10;
+
+  struct Frame
+  {
+    int minX, maxX, minY, maxY;
+  };
+  Frame getFrame(const Polygon &polygon);
+  bool overlaps(const Frame &a, const Frame &b);
+
+  struct ShapeInfo
+  {
+    double area;
+    Frame frame;
+    size_t vertexes;
+    unsigned char flags;
+  };
+
+  bool isRectangle(const Polygon &polygon);
+  ShapeInfo classify(const Polygon &polygon);
+  std::vector< ShapeInfo > classifyAll(const std::vector< Polygon > &polygons);
+
+  bool hasFlags(const ShapeInfo &shape, unsigned char mask);
+  size_t countFlags(const std::vector< ShapeInfo > &shapes, unsigned char mask);
+}
+
+#endif
@@ -5,17 +5,18 @@
 #include <random>
 #include <fstream>
 #include <iterator>
+#include <sstream>
 
 namespace
 {
   struct FileStrProcessor
   {
-    std::istream& in;
-    std::unordered_map< std::string, finaev::OpenningInfo >& debuts;
+    finaev::globalDebuts& debuts;
     std::ostream& out;
 
-    void operator()(const std::string&)
+    void operator()(const std::string& line)
     {
+      std::istringstream in(line);
       std::string key;
       if (!(in >> key))
       {
@@ -38,7 +39,7 @@ namespace
       in >> std::ws;
       in >> finaev::DelimiterIO{'"'};
       std::getline(in, inf.description, '"');
-      debuts[key] = inf;
+      debuts.insert(key, inf);
       out << "Opening " << key << " successfully added\n";
     }
   };
@@ -61,20 +62,13 @@ namespace
     }
   };
 
-  bool isExactMoves(const finaev::DebutMoves& f, const finaev::DebutMoves& s)
+  struct InBase
   {
-    return f.moves == s.moves;
-  }
-
-  struct СompareMoves
-  {
-    const finaev::DebutMoves& mov;
-    const finaev::globalDebuts& globalOpenings;
+    const std::unordered_map< std::string, bool >& base;
 
-    bool operator()(const std::pair< std::string, bool >& base)
+    bool operator()(const std::string& key) const
     {
-      auto it = globalOpenings.find(base.first);
-      return it != globalOpenings.end() && isExactMoves(it->second.moves, mov);
+      return base.find(key) != base.end();
     }
   };
 
@@ -82,26 +76,17 @@ namespace
   {
     const finaev::globalDebuts& debuts;
     std::vector< std::pair< std::string, std::string > >& results;
-    const finaev::DebutMoves& mov;
+    InBase inBase;
 
-    void operator()(const std::pair< std::string, bool >& baseEntry) const
+    void operator()(const std::string& key) const
     {
-      auto debut = debuts.find(baseEntry.first);
-      if (debut != debuts.end() && debut->second.moves.containsSequence(mov.moves))
+      if (inBase(key))
       {
-        results.emplace_back(baseEntry.first, debut->second.name);
+        results.emplace_back(key, debuts.at(key).name);
       }
     }
   };
 
-  struct KeySorterForFind
-  {
-    bool operator()(const std::pair< std::string, std::string >& a, const std::pair< std::string, std::string >& b) const
-    {
-      return a.first < b.first;
-    }
-  };
-
   struct OutputFormatForFind
   {
     std::ostream& out;
@@ -310,7 +295,7 @@ void finaev::loadDebutsFromFile(const std::string& filename, globalDebuts& debut
   }
   std::vector< std::string > lines;
   std::transform(std::istream_iterator<Str>(file), std::istream_iterator< Str >(),std::back_inserter(lines), StrConvert{});
-  FileStrProcessor processor{ file, debuts, out };
+  FileStrProcessor processor{ debuts, out };
   std::for_each(lines.begin(), lines.end(), std::ref(processor));
 }
 
@@ -338,7 +323,7 @@ void finaev::create_debut(std::istream& in, std::ostream& out, globalDebuts& deb
   in >> std::ws;
   in >> DelimiterIO{'"'};
   std::getline(in, inf.description, '"');
-  debuts[key] = inf;
+  debuts.insert(key, inf);
   out << "Openning " << key << " successfully added";
 }
 
@@ -413,12 +398,12 @@ void finaev::exact_find(std::istream& in, std::ostream& out, const globalDebuts&
     throw std::runtime_error("<NO_DEBUT_BASE>");
   }
   const auto& base = bases.at(baseName);
-  СompareMoves pred{ mov, debuts };
-  auto found = std::find_if(base.begin(), base.end(), pred);
-  if (found != base.end())
+  std::vector< std::string > candidates = debuts.exact(mov);
+  auto found = std::find_if(candidates.begin(), candidates.end(), InBase{ base });
+  if (found != candidates.end())
   {
-    const auto& opening = debuts.at(found->first);
-    out << "Key: " << found->first << "\n";
+    const auto& opening = debuts.at(*found);
+    out << "Key: " << *found << "\n";
     out << "Name: " << opening.name;
   }
   else
@@ -447,10 +432,10 @@ void finaev::find(std::istream& in, std::ostream& out, const globalDebuts& debut
     throw std::runtime_error("<NO_DEBUT_BASE>");
   }
   auto base = bases.find(baseName);
+  std::vector< std::string > keys = debuts.containing(mov);
   std::vector< std::pair< std::string, std::string > > foundOpenings;
-  ResultCollectorForFind collector{ debuts, foundOpenings, mov};
-  std::for_each(base->second.begin(), base->second.end(), collector);
-  std::sort(foundOpenings.begin(), foundOpenings.end(), KeySorterForFind());
+  ResultCollectorForFind collector{ debuts, foundOpenings, InBase{ base->second } };
+  std::for_each(keys.begin(), keys.end(), collector);
   if (foundOpenings.empty())
   {
     throw std::runtime_error("<OPENNING_NOT_FOUND>");
@@ -785,7 +770,11 @@ void finaev::guess(std::istream& in, std::ostream& out, const globalDebuts& debu
   }
   std::random_device rd;
   std::mt19937 gen(rd());
-  std::shuffle(debutsInBase.begin(), debutsInBase.end(), gen);
+  for (size_t i = 0; i < 4; ++i)
+  {
+    std::uniform_int_distribution< size_t > pick(i, debutsInBase.size() - 1);
+    std::swap(debutsInBase[i], debutsInBase[pick(gen)]);
+  }
   debutsInBase.resize(4);
   std::uniform_int_distribution<> distr(0, 3);
   const size_t correctIndex = distr(gen);
@@ -6,10 +6,11 @@
 #include <functional>
 #include <algorithm>
 #include "openningInfo.hpp"
+#include "debutLibrary.hpp"
 
 namespace finaev
 {
-  using globalDebuts = std::unordered_map< std::string, finaev::OpenningInfo >;
+  using globalDebuts = finaev::DebutLibrary;
   using debutsBases = std::unordered_map< std::string, std::unordered_map< std::string, bool > >;
   using mapOfCommands = std::map< std::string, std::function< void() > >;
 
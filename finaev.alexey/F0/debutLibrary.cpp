@@ -0,0 +1,327 @@
+#include "debutLibrary.hpp"
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+namespace
+{
+  constexpr size_t noState = std::numeric_limits< size_t >::max();
+  constexpr size_t root = 0;
+
+  struct MoveLess
+  {
+    bool operator()(const std::pair< size_t, size_t >& edge, size_t move) const
+    {
+      return edge.first < move;
+    }
+  };
+
+  struct IsRemoved
+  {
+    const std::vector< bool >& alive;
+
+    bool operator()(size_t id) const
+    {
+      return !alive[id];
+    }
+  };
+}
+
+finaev::MoveIndex::MoveIndex():
+  moveIds_(),
+  states_(1, State{ {}, noState, 0, {}, {} }),
+  lengths_(),
+  alive_(),
+  aliveCount_(0),
+  linkTree_(),
+  treeDirty_(true)
+{}
+
+size_t finaev::MoveIndex::add(const std::vector< std::string >& moves)
+{
+  size_t id = alive_.size();
+  alive_.push_back(true);
+  lengths_.push_back(moves.size());
+  ++aliveCount_;
+  size_t last = root;
+  for (auto it = moves.begin(); it != moves.end(); ++it)
+  {
+    auto res = moveIds_.insert(std::make_pair(*it, moveIds_.size()));
+    last = extend(last, res.first->second);
+    states_[last].ends.push_back(id);
+  }
+  states_[last].whole.push_back(id);
+  treeDirty_ = true;
+  return id;
+}
+
+void finaev::MoveIndex::remove(size_t id)
+{
+  if (id < alive_.size() && alive_[id])
+  {
+    alive_[id] = false;
+    --aliveCount_;
+  }
+}
+
+void finaev::MoveIndex::clear()
+{
+  moveIds_.clear();
+  states_.assign(1, State{ {}, noState, 0, {}, {} });
+  lengths_.clear();
+  alive_.clear();
+  aliveCount_ = 0;
+  linkTree_.clear();
+  treeDirty_ = true;
+}
+
+size_t finaev::MoveIndex::alive() const
+{
+  return aliveCount_;
+}
+
+size_t finaev::MoveIndex::dead() const
+{
+  return alive_.size() - aliveCount_;
+}
+
+std::vector< size_t > finaev::MoveIndex::containing(const std::vector< std::string >& sequence) const
+{
+  std::vector< size_t > result;
+  if (sequence.empty())
+  {
+    return result;
+  }
+  size_t start = walk(sequence);
+  if (start == noState)
+  {
+    return result;
+  }
+  const std::vector< std::vector< size_t > >& tree = linkTree();
+  std::vector< size_t > stack(1, start);
+  while (!stack.empty())
+  {
+    size_t state = stack.back();
+    stack.pop_back();
+    const std::vector< size_t >& ends = states_[state].ends;
+    std::copy(ends.begin(), ends.end(), std::back_inserter(result));
+    std::copy(tree[state].begin(), tree[state].end(), std::back_inserter(stack));
+  }
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  result.erase(std::remove_if(result.begin(), result.end(), IsRemoved{ alive_ }), result.end());
+  return result;
+}
+
+std::vector< size_t > finaev::MoveIndex::exact(const std::vector< std::string >& sequence) const
+{
+  std::vector< size_t > result;
+  size_t state = walk(sequence);
+  if (state == noState)
+  {
+    return result;
+  }
+  const std::vector< size_t >& whole = states_[state].whole;
+  IsRemoved removed{ alive_ };
+  for (auto it = whole.begin(); it != whole.end(); ++it)
+  {
+    if (!removed(*it) && lengths_[*it] == sequence.size())
+    {
+      result.push_back(*it);
+    }
+  }
+  return result;
+}
+
+size_t finaev::MoveIndex::target(size_t state, size_t move) const
+{
+  const std::vector< std::pair< size_t, size_t > >& next = states_[state].next;
+  auto it = std::lower_bound(next.begin(), next.end(), move, MoveLess{});
+  return (it != next.end() && it->first == move) ? it->second : noState;
+}
+
+void finaev::MoveIndex::setTarget(size_t state, size_t move, size_t to)
+{
+  std::vector< std::pair< size_t, size_t > >& next = states_[state].next;
+  auto it = std::lower_bound(next.begin(), next.end(), move, MoveLess{});
+  if (it != next.end() && it->first == move)
+  {
+    it->second = to;
+  }
+  else
+  {
+    next.insert(it, std::make_pair(move, to));
+  }
+}
+
+size_t finaev::MoveIndex::cloneState(size_t state, size_t length)
+{
+  size_t clone = states_.size();
+  states_.push_back(State{ states_[state].next, states_[state].link, length, {}, {} });
+  states_[state].link = clone;
+  return clone;
+}
+
+size_t finaev::MoveIndex::extend(size_t last, size_t move)
+{
+  size_t length = states_[last].length + 1;
+  size_t existing = target(last, move);
+  if (existing != noState)
+  {
+    if (states_[existing].length == length)
+    {
+      return existing;
+    }
+    size_t clone = cloneState(existing, length);
+    for (size_t p = last; p != noState && target(p, move) == existing; p = states_[p].link)
+    {
+      setTarget(p, move, clone);
+    }
+    return clone;
+  }
+  size_t current = states_.size();
+  states_.push_back(State{ {}, root, length, {}, {} });
+  size_t p = last;
+  for (; p != noState && target(p, move) == noState; p = states_[p].link)
+  {
+    setTarget(p, move, current);
+  }
+  if (p == noState)
+  {
+    return current;
+  }
+  size_t q = target(p, move);
+  if (states_[p].length + 1 == states_[q].length)
+  {
+    states_[current].link = q;
+    return current;
+  }
+  size_t clone = cloneState(q, states_[p].length + 1);
+  for (; p != noState && target(p, move) == q; p = states_[p].link)
+  {
+    setTarget(p, move, clone);
+  }
+  states_[current].link = clone;
+  return current;
+}
+
+size_t finaev::MoveIndex::walk(const std::vector< std::string >& sequence) const
+{
+  size_t state = root;
+  for (auto it = sequence.begin(); it != sequence.end() && state != noState; ++it)
+  {
+    auto id = moveIds_.find(*it);
+    state = (id != moveIds_.end()) ? target(state, id->second) : noState;
+  }
+  return state;
+}
+
+const std::vector< std::vector< size_t > >& finaev::MoveIndex::linkTree() const
+{
+  if (treeDirty_)
+  {
+    linkTree_.assign(states_.size(), std::vector< size_t >());
+    for (size_t state = 1; state < states_.size(); ++state)
+    {
+      linkTree_[states_[state].link].push_back(state);
+    }
+    treeDirty_ = false;
+  }
+  return linkTree_;
+}
+
+finaev::DebutLibrary::const_iterator finaev::DebutLibrary::begin() const
+{
+  return debuts_.begin();
+}
+
+finaev::DebutLibrary::const_iterator finaev::DebutLibrary::end() const
+{
+  return debuts_.end();
+}
+
+finaev::DebutLibrary::const_iterator finaev::DebutLibrary::find(const std::string& key) const
+{
+  return debuts_.find(key);
+}
+
+const finaev::OpenningInfo& finaev::DebutLibrary::at(const std::string& key) const
+{
+  return debuts_.at(key);
+}
+
+size_t finaev::DebutLibrary::size() const
+{
+  return debuts_.size();
+}
+
+bool finaev::DebutLibrary::insert(const std::string& key, const OpenningInfo& info)
+{
+  if (!debuts_.insert(std::make_pair(key, info)).second)
+  {
+    return false;
+  }
+  size_t id = index_.add(info.moves.moves);
+  ids_[key] = id;
+  keys_.push_back(key);
+  return true;
+}
+
+size_t finaev::DebutLibrary::erase(const std::string& key)
+{
+  auto it = debuts_.find(key);
+  if (it == debuts_.end())
+  {
+    return 0;
+  }
+  erase(it);
+  return 1;
+}
+
+finaev::DebutLibrary::const_iterator finaev::DebutLibrary::erase(const_iterator pos)
+{
+  auto id = ids_.find(pos->first);
+  index_.remove(id->second);
+  keys_[id->second].clear();
+  ids_.erase(id);
+  auto next = debuts_.erase(pos);
+  if (index_.dead() > index_.alive())
+  {
+    reindex();
+  }
+  return next;
+}
+
+std::vector< std::string > finaev::DebutLibrary::containing(const DebutMoves& sequence) const
+{
+  return toKeys(index_.containing(sequence.moves));
+}
+
+std::vector< std::string > finaev::DebutLibrary::exact(const DebutMoves& sequence) const
+{
+  return toKeys(index_.exact(sequence.moves));
+}
+
+void finaev::DebutLibrary::reindex()
+{
+  index_.clear();
+  ids_.clear();
+  keys_.clear();
+  for (auto it = debuts_.begin(); it != debuts_.end(); ++it)
+  {
+    ids_[it->first] = index_.add(it->second.moves.moves);
+    keys_.push_back(it->first);
+  }
+}
+
+std::vector< std::string > finaev::DebutLibrary::toKeys(const std::vector< size_t >& ids) const
+{
+  std::vector< std::string > result;
+  result.reserve(ids.size());
+  for (auto it = ids.begin(); it != ids.end(); ++it)
+  {
+    result.push_back(keys_[*it]);
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
@@ -0,0 +1,82 @@
+#ifndef DEBUTLIBRARY_HPP
+#define DEBUTLIBRARY_HPP
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "openningInfo.hpp"
+
+namespace finaev
+{
+  class MoveIndex
+  {
+  public:
+    MoveIndex();
+
+    size_t add(const std::vector< std::string >& moves);
+    void remove(size_t id);
+    void clear();
+    size_t alive() const;
+    size_t dead() const;
+
+    std::vector< size_t > containing(const std::vector< std::string >& sequence) const;
+    std::vector< size_t > exact(const std::vector< std::string >& sequence) const;
+
+  private:
+    struct State
+    {
+      std::vector< std::pair< size_t, size_t > > next;
+      size_t link;
+      size_t length;
+      std::vector< size_t > ends;
+      std::vector< size_t > whole;
+    };
+
+    std::unordered_map< std::string, size_t > moveIds_;
+    std::vector< State > states_;
+    std::vector< size_t > lengths_;
+    std::vector< bool > alive_;
+    size_t aliveCount_;
+    mutable std::vector< std::vector< size_t > > linkTree_;
+    mutable bool treeDirty_;
+
+    size_t target(size_t state, size_t move) const;
+    void setTarget(size_t state, size_t move, size_t to);
+    size_t cloneState(size_t state, size_t length);
+    size_t extend(size_t last, size_t move);
+    size_t walk(const std::vector< std::string >& sequence) const;
+    const std::vector< std::vector< size_t > >& linkTree() const;
+  };
+
+  class DebutLibrary
+  {
+  public:
+    using container_type = std::unordered_map< std::string, OpenningInfo >;
+    using value_type = container_type::value_type;
+    using const_iterator = container_type::const_iterator;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator find(const std::string& key) const;
+    const OpenningInfo& at(const std::string& key) const;
+    size_t size() const;
+
+    bool insert(const std::string& key, const OpenningInfo& info);
+    size_t erase(const std::string& key);
+    const_iterator erase(const_iterator pos);
+
+    std::vector< std::string > containing(const DebutMoves& sequence) const;
+    std::vector< std::string > exact(const DebutMoves& sequence) const;
+
+  private:
+    container_type debuts_;
+    std::unordered_map< std::string, size_t > ids_;
+    std::vector< std::string > keys_;
+    MoveIndex index_;
+
+    void reindex();
+    std::vector< std::string > toKeys(const std::vector< size_t >& ids) const;
+  };
+}
+
+#endif
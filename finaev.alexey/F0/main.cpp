@@ -7,12 +7,12 @@
 
 int main(int argc, char* argv[])
 {
-  if (argc != 2)
+  if (argc != 1 && argc != 3)
   {
     std::cerr << "Uncorrect input\n";
     return 1;
   }
-  std::unordered_map< std::string, finaev::OpenningInfo > globalOpenings;
+  finaev::globalDebuts globalOpenings;
   std::unordered_map< std::string, std::unordered_map< std::string, bool > > bases;
   if (argc > 1)
   {
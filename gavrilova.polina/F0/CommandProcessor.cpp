@@ -51,6 +51,7 @@ gavrilova::CommandProcessor::CommandProcessor(StudentDatabase& db):
   commandMap_["create_group"] = std::bind(&CommandProcessor::handleCreateGroup, this);
   commandMap_["save"] = std::bind(&CommandProcessor::handleSave, this);
   commandMap_["loadbase"] = std::bind(&CommandProcessor::handleLoad, this);
+  commandMap_["compact"] = std::bind(&CommandProcessor::handleCompact, this);
 }
 
 void gavrilova::CommandProcessor::run()
@@ -92,6 +93,7 @@ void gavrilova::CommandProcessor::handleHelp()
                "create_group <группа>\n"
                "save <файл>\n"
                "loadbase <файл>\n"
+               "compact\n"
                "clear\n";
 }
 
@@ -363,3 +365,12 @@ void gavrilova::CommandProcessor::handleLoad()
     std::cout << "Ошибка загрузки файла.\n";
   }
 }
+
+void gavrilova::CommandProcessor::handleCompact()
+{
+  if (db_.compact()) {
+    std::cout << "Журнал сжат в снимок базы данных.\n";
+  } else {
+    std::cout << "Ошибка сжатия: хранилище не открыто или недоступно.\n";
+  }
+}
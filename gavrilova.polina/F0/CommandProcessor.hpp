@@ -40,6 +40,7 @@ namespace gavrilova {
     void handleCreateGroup();
     void handleSave();
     void handleLoad();
+    void handleCompact();
   };
 
 }
@@ -0,0 +1,133 @@
+#include "GradeTable.hpp"
+#include <functional>
+
+bool gavrilova::GradeTable::RowKey::operator==(const RowKey& other) const
+{
+  return id == other.id && date == other.date;
+}
+
+size_t gavrilova::GradeTable::RowKeyHash::operator()(const RowKey& key) const
+{
+  return std::hash< unsigned long long >()((static_cast< unsigned long long >(key.id) << 25) ^ key.date);
+}
+
+gavrilova::GradeTable::RowKey gavrilova::GradeTable::makeKey(StudentID id, const date::Date& date)
+{
+  return {id, (date.year * 100 + date.month) * 100 + date.day};
+}
+
+size_t gavrilova::GradeTable::size() const
+{
+  return grades_.size();
+}
+
+size_t gavrilova::GradeTable::find(StudentID id, const date::Date& date) const
+{
+  auto it = rows_.find(makeKey(id, date));
+  return (it != rows_.end()) ? it->second : npos;
+}
+
+size_t gavrilova::GradeTable::insert(StudentID id, const date::Date& date, int grade)
+{
+  size_t row = grades_.size();
+  rows_.emplace(makeKey(id, date), row);
+  students_.push_back(id);
+  dates_.push_back(date);
+  grades_.push_back(grade);
+  next_.push_back(first(id));
+  heads_[id] = row;
+  return row;
+}
+
+void gavrilova::GradeTable::erase(size_t row)
+{
+  unlink(row);
+  rows_.erase(makeKey(students_[row], dates_[row]));
+
+  size_t last = grades_.size() - 1;
+  if (row != last) {
+    relink(last, row);
+    students_[row] = students_[last];
+    dates_[row] = dates_[last];
+    grades_[row] = grades_[last];
+    next_[row] = next_[last];
+  }
+  students_.pop_back();
+  dates_.pop_back();
+  grades_.pop_back();
+  next_.pop_back();
+}
+
+void gavrilova::GradeTable::clear()
+{
+  students_.clear();
+  dates_.clear();
+  grades_.clear();
+  next_.clear();
+  heads_.clear();
+  rows_.clear();
+}
+
+size_t gavrilova::GradeTable::first(StudentID id) const
+{
+  auto it = heads_.find(id);
+  return (it != heads_.end()) ? it->second : npos;
+}
+
+size_t gavrilova::GradeTable::next(size_t row) const
+{
+  return next_[row];
+}
+
+gavrilova::StudentID gavrilova::GradeTable::student(size_t row) const
+{
+  return students_[row];
+}
+
+const gavrilova::date::Date& gavrilova::GradeTable::date(size_t row) const
+{
+  return dates_[row];
+}
+
+int gavrilova::GradeTable::grade(size_t row) const
+{
+  return grades_[row];
+}
+
+void gavrilova::GradeTable::setGrade(size_t row, int grade)
+{
+  grades_[row] = grade;
+}
+
+void gavrilova::GradeTable::unlink(size_t row)
+{
+  auto head = heads_.find(students_[row]);
+  if (head->second == row) {
+    if (next_[row] == npos) {
+      heads_.erase(head);
+    } else {
+      head->second = next_[row];
+    }
+    return;
+  }
+  size_t prev = head->second;
+  while (next_[prev] != row) {
+    prev = next_[prev];
+  }
+  next_[prev] = next_[row];
+}
+
+void gavrilova::GradeTable::relink(size_t from, size_t to)
+{
+  rows_[makeKey(students_[from], dates_[from])] = to;
+  auto head = heads_.find(students_[from]);
+  if (head->second == from) {
+    head->second = to;
+    return;
+  }
+  size_t prev = head->second;
+  while (next_[prev] != from) {
+    prev = next_[prev];
+  }
+  next_[prev] = to;
+}
@@ -0,0 +1,55 @@
+#ifndef GRADE_TABLE_HPP
+#define GRADE_TABLE_HPP
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+#include "Date.hpp"
+#include "Student.hpp"
+
+namespace gavrilova {
+
+  class GradeTable {
+  public:
+    static constexpr size_t npos = static_cast< size_t >(-1);
+
+    size_t size() const;
+    size_t find(StudentID id, const date::Date& date) const;
+    size_t insert(StudentID id, const date::Date& date, int grade);
+    void erase(size_t row);
+    void clear();
+
+    size_t first(StudentID id) const;
+    size_t next(size_t row) const;
+
+    StudentID student(size_t row) const;
+    const date::Date& date(size_t row) const;
+    int grade(size_t row) const;
+    void setGrade(size_t row, int grade);
+
+  private:
+    struct RowKey {
+      StudentID id;
+      int date;
+      bool operator==(const RowKey& other) const;
+    };
+
+    struct RowKeyHash {
+      size_t operator()(const RowKey& key) const;
+    };
+
+    std::vector< StudentID > students_;
+    std::vector< date::Date > dates_;
+    std::vector< int > grades_;
+    std::vector< size_t > next_;
+    std::unordered_map< StudentID, size_t > heads_;
+    std::unordered_map< RowKey, size_t, RowKeyHash > rows_;
+
+    static RowKey makeKey(StudentID id, const date::Date& date);
+    void unlink(size_t row);
+    void relink(size_t from, size_t to);
+  };
+
+}
+
+#endif
@@ -0,0 +1,329 @@
+#include "Journal.hpp"
+#include <iterator>
+
+namespace {
+  const char journalMagic[4] = {'G', 'S', 'D', 'J'};
+  const unsigned long journalVersion = 1;
+  const size_t headerSize = 16;
+  const size_t maxRecordSize = 1 << 20;
+}
+
+void gavrilova::journal::Encoder::putU8(unsigned char value)
+{
+  data_.push_back(static_cast< char >(value));
+}
+
+void gavrilova::journal::Encoder::putU32(unsigned long value)
+{
+  for (int shift = 0; shift < 32; shift += 8) {
+    putU8(static_cast< unsigned char >((value >> shift) & 0xFF));
+  }
+}
+
+void gavrilova::journal::Encoder::putU64(unsigned long long value)
+{
+  for (int shift = 0; shift < 64; shift += 8) {
+    putU8(static_cast< unsigned char >((value >> shift) & 0xFF));
+  }
+}
+
+void gavrilova::journal::Encoder::putI32(int value)
+{
+  putU32(static_cast< unsigned long >(static_cast< unsigned int >(value)));
+}
+
+void gavrilova::journal::Encoder::putString(const std::string& value)
+{
+  putU32(value.size());
+  data_.append(value);
+}
+
+void gavrilova::journal::Encoder::putDate(const date::Date& value)
+{
+  putI32((value.year * 100 + value.month) * 100 + value.day);
+}
+
+void gavrilova::journal::Encoder::putRecord(const Record& record)
+{
+  putU8(static_cast< unsigned char >(record.op));
+  switch (record.op) {
+  case Op::createGroup:
+    putString(record.group);
+    break;
+  case Op::addStudent:
+    putU64(record.id);
+    putString(record.name);
+    putString(record.group);
+    break;
+  case Op::deleteStudent:
+    putU64(record.id);
+    break;
+  case Op::moveStudent:
+    putU64(record.id);
+    putString(record.group);
+    break;
+  case Op::addGrade:
+  case Op::changeGrade:
+    putU64(record.id);
+    putDate(record.date);
+    putI32(record.grade);
+    break;
+  case Op::removeGrade:
+    putU64(record.id);
+    putDate(record.date);
+    break;
+  case Op::clear:
+    break;
+  }
+}
+
+const std::string& gavrilova::journal::Encoder::data() const
+{
+  return data_;
+}
+
+void gavrilova::journal::Encoder::clear()
+{
+  data_.clear();
+}
+
+gavrilova::journal::Decoder::Decoder(const char* data, size_t size):
+  data_(data),
+  size_(size),
+  pos_(0),
+  ok_(true)
+{}
+
+bool gavrilova::journal::Decoder::take(size_t count)
+{
+  if (!ok_ || size_ - pos_ < count) {
+    ok_ = false;
+    return false;
+  }
+  return true;
+}
+
+unsigned char gavrilova::journal::Decoder::getU8()
+{
+  if (!take(1)) {
+    return 0;
+  }
+  return static_cast< unsigned char >(data_[pos_++]);
+}
+
+unsigned long gavrilova::journal::Decoder::getU32()
+{
+  if (!take(4)) {
+    return 0;
+  }
+  unsigned long value = 0;
+  for (int shift = 0; shift < 32; shift += 8) {
+    value |= static_cast< unsigned long >(static_cast< unsigned char >(data_[pos_++])) << shift;
+  }
+  return value;
+}
+
+unsigned long long gavrilova::journal::Decoder::getU64()
+{
+  if (!take(8)) {
+    return 0;
+  }
+  unsigned long long value = 0;
+  for (int shift = 0; shift < 64; shift += 8) {
+    value |= static_cast< unsigned long long >(static_cast< unsigned char >(data_[pos_++])) << shift;
+  }
+  return value;
+}
+
+int gavrilova::journal::Decoder::getI32()
+{
+  return static_cast< int >(static_cast< unsigned int >(getU32()));
+}
+
+std::string gavrilova::journal::Decoder::getString()
+{
+  size_t length = getU32();
+  if (!take(length)) {
+    return {};
+  }
+  std::string value(data_ + pos_, length);
+  pos_ += length;
+  return value;
+}
+
+gavrilova::date::Date gavrilova::journal::Decoder::getDate()
+{
+  int packed = getI32();
+  return {packed / 10000, packed / 100 % 100, packed % 100};
+}
+
+gavrilova::journal::Record gavrilova::journal::Decoder::getRecord()
+{
+  Record record;
+  record.op = static_cast< Op >(getU8());
+  switch (record.op) {
+  case Op::createGroup:
+    record.group = getString();
+    break;
+  case Op::addStudent:
+    record.id = getU64();
+    record.name = getString();
+    record.group = getString();
+    break;
+  case Op::deleteStudent:
+    record.id = getU64();
+    break;
+  case Op::moveStudent:
+    record.id = getU64();
+    record.group = getString();
+    break;
+  case Op::addGrade:
+  case Op::changeGrade:
+    record.id = getU64();
+    record.date = getDate();
+    record.grade = getI32();
+    break;
+  case Op::removeGrade:
+    record.id = getU64();
+    record.date = getDate();
+    break;
+  case Op::clear:
+    break;
+  default:
+    ok_ = false;
+  }
+  return record;
+}
+
+bool gavrilova::journal::Decoder::ok() const
+{
+  return ok_;
+}
+
+bool gavrilova::journal::Decoder::atEnd() const
+{
+  return pos_ == size_;
+}
+
+size_t gavrilova::journal::Decoder::offset() const
+{
+  return pos_;
+}
+
+unsigned long gavrilova::journal::checksum(const char* data, size_t size)
+{
+  unsigned long hash = 2166136261UL;
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= static_cast< unsigned char >(data[i]);
+    hash = (hash * 16777619UL) & 0xFFFFFFFFUL;
+  }
+  return hash;
+}
+
+gavrilova::journal::Journal::Journal():
+  out_(),
+  frame_(),
+  records_(0)
+{}
+
+bool gavrilova::journal::Journal::create(const std::string& path, unsigned long long generation)
+{
+  close();
+  out_.open(path, std::ios::binary | std::ios::trunc);
+  Encoder header;
+  for (char c: journalMagic) {
+    header.putU8(static_cast< unsigned char >(c));
+  }
+  header.putU32(journalVersion);
+  header.putU64(generation);
+  out_.write(header.data().data(), header.data().size());
+  out_.flush();
+  if (!out_) {
+    close();
+    return false;
+  }
+  return true;
+}
+
+bool gavrilova::journal::Journal::append(const Record& record)
+{
+  if (!out_.is_open()) {
+    return false;
+  }
+
+  Encoder body;
+  body.putRecord(record);
+  frame_.clear();
+  frame_.putU32(body.data().size());
+  frame_.putU32(checksum(body.data().data(), body.data().size()));
+  out_.write(frame_.data().data(), frame_.data().size());
+  out_.write(body.data().data(), body.data().size());
+  out_.flush();
+  if (!out_) {
+    close();
+    return false;
+  }
+  ++records_;
+  return true;
+}
+
+void gavrilova::journal::Journal::close()
+{
+  if (out_.is_open()) {
+    out_.close();
+  }
+  out_.clear();
+  records_ = 0;
+}
+
+bool gavrilova::journal::Journal::isOpen() const
+{
+  return out_.is_open();
+}
+
+size_t gavrilova::journal::Journal::records() const
+{
+  return records_;
+}
+
+bool gavrilova::journal::Journal::read(const std::string& path, unsigned long long generation,
+    std::vector< Record >& records)
+{
+  records.clear();
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    return true;
+  }
+  std::string content((std::istreambuf_iterator< char >(in)), std::istreambuf_iterator< char >());
+
+  Decoder header(content.data(), content.size());
+  bool magicOk = true;
+  for (char c: journalMagic) {
+    magicOk = (header.getU8() == static_cast< unsigned char >(c)) && magicOk;
+  }
+  if (!magicOk || header.getU32() != journalVersion || header.getU64() != generation || !header.ok()) {
+    return false;
+  }
+
+  size_t pos = headerSize;
+  while (pos < content.size()) {
+    Decoder frame(content.data() + pos, content.size() - pos);
+    size_t length = frame.getU32();
+    unsigned long sum = frame.getU32();
+    if (!frame.ok() || length > maxRecordSize || content.size() - pos - frame.offset() < length) {
+      return false;
+    }
+    const char* body = content.data() + pos + frame.offset();
+    if (checksum(body, length) != sum) {
+      return false;
+    }
+    Decoder decoder(body, length);
+    Record record = decoder.getRecord();
+    if (!decoder.ok() || !decoder.atEnd()) {
+      return false;
+    }
+    records.push_back(record);
+    pos += frame.offset() + length;
+  }
+  return true;
+}
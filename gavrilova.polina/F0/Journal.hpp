@@ -0,0 +1,98 @@
+#ifndef JOURNAL_HPP
+#define JOURNAL_HPP
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Date.hpp"
+#include "Student.hpp"
+
+namespace gavrilova {
+  namespace journal {
+
+    enum class Op: unsigned char {
+      createGroup = 1,
+      addStudent,
+      deleteStudent,
+      moveStudent,
+      addGrade,
+      changeGrade,
+      removeGrade,
+      clear
+    };
+
+    struct Record {
+      Op op;
+      StudentID id = 0;
+      std::string name;
+      std::string group;
+      date::Date date = {0, 0, 0};
+      int grade = 0;
+    };
+
+    class Encoder {
+    public:
+      void putU8(unsigned char value);
+      void putU32(unsigned long value);
+      void putU64(unsigned long long value);
+      void putI32(int value);
+      void putString(const std::string& value);
+      void putDate(const date::Date& value);
+      void putRecord(const Record& record);
+
+      const std::string& data() const;
+      void clear();
+
+    private:
+      std::string data_;
+    };
+
+    class Decoder {
+    public:
+      Decoder(const char* data, size_t size);
+
+      unsigned char getU8();
+      unsigned long getU32();
+      unsigned long long getU64();
+      int getI32();
+      std::string getString();
+      date::Date getDate();
+      Record getRecord();
+
+      bool ok() const;
+      bool atEnd() const;
+      size_t offset() const;
+
+    private:
+      const char* data_;
+      size_t size_;
+      size_t pos_;
+      bool ok_;
+
+      bool take(size_t count);
+    };
+
+    unsigned long checksum(const char* data, size_t size);
+
+    class Journal {
+    public:
+      Journal();
+
+      bool create(const std::string& path, unsigned long long generation);
+      bool append(const Record& record);
+      void close();
+      bool isOpen() const;
+      size_t records() const;
+
+      static bool read(const std::string& path, unsigned long long generation, std::vector< Record >& records);
+
+    private:
+      std::ofstream out_;
+      Encoder frame_;
+      size_t records_;
+    };
+  }
+}
+
+#endif
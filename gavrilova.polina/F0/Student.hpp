@@ -17,12 +17,16 @@ namespace gavrilova {
       std::string group_;
       std::map< gavrilova::date::Date, int > grades_;
       double averageGrade_;
+      long long gradeSum_;
+      size_t gradeCount_;
 
       Student():
         id_(0),
         fullName_(""),
         group_(""),
-        averageGrade_(0.0)
+        averageGrade_(0.0),
+        gradeSum_(0),
+        gradeCount_(0)
       {}
 
       Student(StudentID id, const std::string& fullName, const std::string& group):
@@ -30,7 +34,9 @@ namespace gavrilova {
         fullName_(fullName),
         group_(group),
         grades_(),
-        averageGrade_(0.0)
+        averageGrade_(0.0),
+        gradeSum_(0),
+        gradeCount_(0)
       {}
     };
 
@@ -1,13 +1,19 @@
 #include "StudentsDataBase.hpp"
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
 #include <fstream>
 #include <iterator>
+#include <limits>
 #include <numeric>
 #include <stdexcept>
 
 namespace {
 
+  const char snapshotMagic[4] = {'G', 'S', 'D', 'B'};
+  const unsigned long snapshotVersion = 1;
+  const size_t minCompactRecords = 4096;
+
   template < typename Pair >
   struct PairToSecond {
     const typename Pair::second_type& operator()(const Pair& p) const
@@ -16,125 +22,153 @@ namespace {
     }
   };
 
-  struct CompareStudentsByGrade {
-    bool operator()(const std::shared_ptr< const gavrilova::student::Student >& a,
-        const std::shared_ptr< const gavrilova::student::Student >& b) const
+  struct RankOrderAsc {
+    bool operator()(const gavrilova::RankKey& a, const gavrilova::RankKey& b) const
     {
-      if (a->averageGrade_ == b->averageGrade_) {
-        return a->id_ < b->id_;
+      if (a.average == b.average) {
+        return a.id < b.id;
       }
-      return a->averageGrade_ > b->averageGrade_;
+      return a.average < b.average;
     }
   };
 
-  struct CompareStudentsByGradeAsc {
-    bool operator()(const std::shared_ptr< const gavrilova::student::Student >& a,
-        const std::shared_ptr< const gavrilova::student::Student >& b) const
+  struct RankKeyToId {
+    gavrilova::StudentID operator()(const gavrilova::RankKey& key) const
     {
-      if (a->averageGrade_ == b->averageGrade_) {
-        return a->id_ < b->id_;
-      }
-      return a->averageGrade_ < b->averageGrade_;
+      return key.id;
     }
   };
 
-  struct IsGradeInPeriod {
-    const gavrilova::DateRange& period;
-    bool operator()(const std::pair< gavrilova::date::Date, int >& grade) const
-    {
-      return !(grade.first < period.start) && !(period.end < grade.first);
+  gavrilova::RankKey makeRankKey(const gavrilova::student::Student& student)
+  {
+    return {student.averageGrade_, student.id_};
+  }
+
+  void rankIn(gavrilova::Ranking& ranking, std::set< gavrilova::StudentID >& ungraded,
+      const gavrilova::student::Student& student)
+  {
+    if (student.gradeCount_) {
+      ranking.insert(makeRankKey(student));
+    } else {
+      ungraded.insert(student.id_);
     }
-  };
+  }
 
-  struct GroupStatsAccumulator {
-    const gavrilova::DateRange& period;
-    std::vector< int >& grades;
-    std::map< int, int >& distribution;
+  void unrankIn(gavrilova::Ranking& ranking, std::set< gavrilova::StudentID >& ungraded,
+      const gavrilova::student::Student& student)
+  {
+    if (student.gradeCount_) {
+      ranking.erase(makeRankKey(student));
+    } else {
+      ungraded.erase(student.id_);
+    }
+  }
 
-    void operator()(const std::shared_ptr< const gavrilova::student::Student >& student) const
-    {
-      struct GradeProcessor {
-        const gavrilova::DateRange& p;
-        std::vector< int >& g;
-        std::map< int, int >& d;
-
-        void operator()(const std::pair< gavrilova::date::Date, int >& grade) const
-        {
-          if (IsGradeInPeriod{p}(grade)) {
-            g.push_back(grade.second);
-            d[grade.second]++;
-          }
-        }
-      };
+  void countGrade(std::map< gavrilova::date::Date, gavrilova::DateGrades >& byDate,
+      const gavrilova::date::Date& date, int grade)
+  {
+    gavrilova::DateGrades& entry = byDate[date];
+    entry.totals.sum += grade;
+    ++entry.totals.count;
+    ++entry.distribution[grade];
+  }
 
-      std::for_each(student->grades_.begin(), student->grades_.end(),
-          GradeProcessor{period, grades, distribution});
+  void uncountGrade(std::map< gavrilova::date::Date, gavrilova::DateGrades >& byDate,
+      const gavrilova::date::Date& date, int grade)
+  {
+    auto it = byDate.find(date);
+    if (it == byDate.end()) {
+      return;
     }
-  };
-
-  struct OtherGroupsGradesCollector {
-    const gavrilova::DateRange& period;
-    const std::string& currentGroup;
-    std::vector< int >& grades;
+    gavrilova::DateGrades& entry = it->second;
+    entry.totals.sum -= grade;
+    if (--entry.totals.count == 0) {
+      byDate.erase(it);
+      return;
+    }
+    auto it_grade = entry.distribution.find(grade);
+    if (--it_grade->second == 0) {
+      entry.distribution.erase(it_grade);
+    }
+  }
 
-    void operator()(const std::pair< std::string, gavrilova::StudentDatabase::Group >& group) const
-    {
-      if (group.first == currentGroup) {
-        return;
+  gavrilova::DateGrades sumPeriod(const std::map< gavrilova::date::Date, gavrilova::DateGrades >& byDate,
+      const gavrilova::DateRange& period)
+  {
+    gavrilova::DateGrades result;
+    if (period.end < period.start) {
+      return result;
+    }
+    auto last = byDate.upper_bound(period.end);
+    for (auto it = byDate.lower_bound(period.start); it != last; ++it) {
+      result.totals.sum += it->second.totals.sum;
+      result.totals.count += it->second.totals.count;
+      for (const auto& grade: it->second.distribution) {
+        result.distribution[grade.first] += grade.second;
       }
+    }
+    return result;
+  }
 
-      struct StudentProcessor {
-        const gavrilova::DateRange& p;
-        std::vector< int >& g;
-
-        void operator()(const std::pair< gavrilova::StudentID,
-            std::shared_ptr< gavrilova::student::Student > >& student) const
-        {
-          struct GradeExtractor {
-            const gavrilova::DateRange& period;
-            std::vector< int >& grades;
-
-            void operator()(const std::pair< gavrilova::date::Date, int >& grade) const
-            {
-              if (IsGradeInPeriod{period}(grade)) {
-                grades.push_back(grade.second);
-              }
-            }
-          };
-
-          std::for_each(student.second->grades_.begin(), student.second->grades_.end(),
-              GradeExtractor{p, g});
-        }
-      };
+  double averageOf(const gavrilova::GradeTotals& totals)
+  {
+    return totals.count ? static_cast< double >(totals.sum) / totals.count : 0.0;
+  }
 
-      std::for_each(group.second.begin(), group.second.end(),
-          StudentProcessor{period, grades});
+  std::vector< gavrilova::StudentID > topIds(const gavrilova::Ranking& ranking,
+      const std::set< gavrilova::StudentID >& ungraded, size_t n)
+  {
+    std::vector< gavrilova::StudentID > result;
+    gavrilova::RankOrder less;
+    auto it_ranked = ranking.begin();
+    auto it_ungraded = ungraded.begin();
+    while (result.size() < n && (it_ranked != ranking.end() || it_ungraded != ungraded.end())) {
+      if (it_ungraded == ungraded.end() ||
+          (it_ranked != ranking.end() && less(*it_ranked, gavrilova::RankKey{0.0, *it_ungraded}))) {
+        result.push_back((it_ranked++)->id);
+      } else {
+        result.push_back(*it_ungraded++);
+      }
     }
-  };
+    return result;
+  }
 
-  struct IsRiskStudentPredicate {
-    double threshold;
-    bool operator()(const std::pair< gavrilova::StudentID,
-        std::shared_ptr< gavrilova::student::Student > >& p) const
-    {
-      return !p.second->grades_.empty() && p.second->averageGrade_ < threshold;
+  std::vector< gavrilova::StudentID > bottomIds(const gavrilova::Ranking& ranking,
+      const std::set< gavrilova::StudentID >& ungraded, size_t n)
+  {
+    if (n == 0) {
+      return {};
     }
-  };
-
-  struct IsRiskStudentInGroupPredicate {
-    double threshold;
-    bool operator()(const std::shared_ptr< const gavrilova::student::Student >& s) const
-    {
-      return !s->grades_.empty() && s->averageGrade_ < threshold;
+    std::vector< gavrilova::RankKey > candidates;
+    for (auto it = ranking.rbegin(); it != ranking.rend(); ++it) {
+      if (candidates.size() >= n && it->average != candidates.back().average) {
+        break;
+      }
+      candidates.push_back(*it);
     }
-  };
+    auto it_ungraded = ungraded.begin();
+    for (size_t i = 0; i < n && it_ungraded != ungraded.end(); ++i) {
+      candidates.push_back(gavrilova::RankKey{0.0, *it_ungraded++});
+    }
+    std::sort(candidates.begin(), candidates.end(), RankOrderAsc{});
+    candidates.resize(std::min(n, candidates.size()));
 
-  struct GradePairAccumulator {
-    double operator()(double sum, const std::pair< gavrilova::StudentID, int >& p) const
-    {
-      return sum + p.second;
+    std::vector< gavrilova::StudentID > result;
+    std::transform(candidates.begin(), candidates.end(), std::back_inserter(result), RankKeyToId{});
+    return result;
+  }
+
+  std::vector< gavrilova::StudentID > riskIds(const gavrilova::Ranking& ranking, double threshold)
+  {
+    if (std::isnan(threshold)) {
+      return {};
     }
-  };
+    auto first = ranking.upper_bound(gavrilova::RankKey{threshold, std::numeric_limits< gavrilova::StudentID >::max()});
+    std::vector< gavrilova::StudentID > result;
+    std::transform(first, ranking.end(), std::back_inserter(result), RankKeyToId{});
+    std::sort(result.begin(), result.end());
+    return result;
+  }
 
   struct StudentAdder {
     gavrilova::StudentDatabase& db;
@@ -148,10 +182,8 @@ namespace {
       bool ok = pair.first;
       gavrilova::StudentID id = pair.second;
       if (ok) {
-        auto sp = db.findStudentById(id);
-        if (sp) {
-          sp->grades_ = stud.grades_;
-          db.updateStudentAverageGrade(sp);
+        for (const auto& grade: stud.grades_) {
+          db.addGrade(id, grade.second, grade.first);
         }
       }
     }
@@ -159,10 +191,16 @@ namespace {
 
   struct StudentToFileWriter {
     std::ostream& out;
+    const gavrilova::GradeTable& gradeTable;
+
     void operator()(const std::pair< gavrilova::StudentID,
         std::shared_ptr< gavrilova::student::Student > >& p) const
     {
-      out << *p.second << '\n';
+      gavrilova::student::Student student = *p.second;
+      for (size_t row = gradeTable.first(p.first); row != gavrilova::GradeTable::npos; row = gradeTable.next(row)) {
+        student.grades_[gradeTable.date(row)] = gradeTable.grade(row);
+      }
+      out << student << '\n';
     }
   };
 
@@ -201,9 +239,18 @@ namespace {
   };
 }
 
+bool gavrilova::RankOrder::operator()(const RankKey& a, const RankKey& b) const
+{
+  if (a.average == b.average) {
+    return a.id < b.id;
+  }
+  return a.average > b.average;
+}
+
 gavrilova::StudentDatabase::StudentDatabase(int id_digits)
 {
   nextId = std::pow(10, id_digits - 1) + 1;
+  storeGeneration = 0;
 }
 
 bool gavrilova::StudentDatabase::saveToFile(const std::string& filename) const
@@ -213,7 +260,7 @@ bool gavrilova::StudentDatabase::saveToFile(const std::string& filename) const
     return false;
   }
 
-  std::for_each(students.begin(), students.end(), StudentToFileWriter{out});
+  std::for_each(students.begin(), students.end(), StudentToFileWriter{out, gradeTable});
   return true;
 }
 
@@ -232,17 +279,224 @@ bool gavrilova::StudentDatabase::loadFromFile(const std::string& filename)
   return true;
 }
 
+bool gavrilova::StudentDatabase::openStore(const std::string& path)
+{
+  journal.close();
+  storePath = path;
+  std::ifstream probe(path + ".snap", std::ios::binary);
+  if (!probe) {
+    storeGeneration = 0;
+    return compact();
+  }
+  probe.close();
+
+  if (!readSnapshot(path + ".snap")) {
+    storePath.clear();
+    return false;
+  }
+  std::vector< journal::Record > tail;
+  bool complete = journal::Journal::read(path + ".journal", storeGeneration, tail);
+  for (const auto& record: tail) {
+    apply(record);
+  }
+  if (!complete || !tail.empty()) {
+    return compact();
+  }
+  return journal.create(path + ".journal", storeGeneration);
+}
+
+bool gavrilova::StudentDatabase::compact()
+{
+  if (storePath.empty()) {
+    return false;
+  }
+  std::string snapshot = storePath + ".snap";
+  std::string temp = snapshot + ".tmp";
+  if (!writeSnapshot(temp, storeGeneration + 1) || std::rename(temp.c_str(), snapshot.c_str()) != 0) {
+    std::remove(temp.c_str());
+    return false;
+  }
+  ++storeGeneration;
+  return journal.create(storePath + ".journal", storeGeneration);
+}
+
+void gavrilova::StudentDatabase::log(const journal::Record& record)
+{
+  if (!journal.isOpen() || !journal.append(record)) {
+    return;
+  }
+  if (journal.records() > std::max(minCompactRecords, students.size() + gradeTable.size())) {
+    compact();
+  }
+}
+
+void gavrilova::StudentDatabase::apply(const journal::Record& record)
+{
+  switch (record.op) {
+  case journal::Op::createGroup:
+    createGroup(record.group);
+    break;
+  case journal::Op::addStudent:
+    if (groupExists(record.group) && !students.count(record.id)) {
+      insertStudent(record.id, record.name, record.group);
+    }
+    break;
+  case journal::Op::deleteStudent:
+    deleteStudent(record.id);
+    break;
+  case journal::Op::moveStudent:
+    moveStudentToGroup(record.id, record.group);
+    break;
+  case journal::Op::addGrade:
+    addGrade(record.id, record.grade, record.date);
+    break;
+  case journal::Op::changeGrade:
+    changeGrade(record.id, record.grade, record.date);
+    break;
+  case journal::Op::removeGrade:
+    removeGradesByDate(record.id, record.date);
+    break;
+  case journal::Op::clear:
+    clear();
+    break;
+  }
+}
+
+bool gavrilova::StudentDatabase::writeSnapshot(const std::string& path, unsigned long long generation) const
+{
+  journal::Encoder out;
+  for (char c: snapshotMagic) {
+    out.putU8(static_cast< unsigned char >(c));
+  }
+  out.putU32(snapshotVersion);
+  out.putU64(generation);
+  out.putU64(nextId);
+
+  out.putU32(groups.size());
+  for (const auto& group: groups) {
+    out.putString(group.first);
+  }
+  out.putU64(students.size());
+  for (const auto& student: students) {
+    out.putU64(student.first);
+    out.putString(student.second->fullName_);
+    out.putString(student.second->group_);
+  }
+  out.putU64(gradeTable.size());
+  for (size_t row = 0; row < gradeTable.size(); ++row) {
+    out.putU64(gradeTable.student(row));
+    out.putDate(gradeTable.date(row));
+    out.putI32(gradeTable.grade(row));
+  }
+  out.putU32(journal::checksum(out.data().data(), out.data().size()));
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(out.data().data(), out.data().size());
+  file.close();
+  return !file.fail();
+}
+
+bool gavrilova::StudentDatabase::readSnapshot(const std::string& path)
+{
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  std::string content((std::istreambuf_iterator< char >(file)), std::istreambuf_iterator< char >());
+  if (content.size() < 4) {
+    return false;
+  }
+  size_t size = content.size() - 4;
+  journal::Decoder trailer(content.data() + size, 4);
+  if (trailer.getU32() != journal::checksum(content.data(), size)) {
+    return false;
+  }
+
+  journal::Decoder in(content.data(), size);
+  bool magicOk = true;
+  for (char c: snapshotMagic) {
+    magicOk = (in.getU8() == static_cast< unsigned char >(c)) && magicOk;
+  }
+  if (!magicOk || in.getU32() != snapshotVersion) {
+    return false;
+  }
+  unsigned long long generation = in.getU64();
+  StudentID savedNextId = in.getU64();
+
+  clear();
+  size_t groupCount = in.getU32();
+  for (size_t i = 0; i < groupCount && in.ok(); ++i) {
+    createGroup(in.getString());
+  }
+  unsigned long long studentCount = in.getU64();
+  for (unsigned long long i = 0; i < studentCount && in.ok(); ++i) {
+    StudentID id = in.getU64();
+    std::string fullName = in.getString();
+    std::string groupName = in.getString();
+    if (!groupExists(groupName) || students.count(id)) {
+      break;
+    }
+    insertStudent(id, fullName, groupName);
+  }
+  unsigned long long gradeCount = in.getU64();
+  for (unsigned long long i = 0; i < gradeCount && in.ok(); ++i) {
+    StudentID id = in.getU64();
+    date::Date date = in.getDate();
+    int grade = in.getI32();
+    auto it_student = students.find(id);
+    if (!in.ok() || it_student == students.end() || gradeTable.find(id, date) != GradeTable::npos) {
+      break;
+    }
+    student::Student& student = *it_student->second;
+    gradeTable.insert(id, date, grade);
+    countGrade(dateGrades, date, grade);
+    countGrade(groupGrades.at(student.group_).byDate, date, grade);
+    student.gradeSum_ += grade;
+    ++student.gradeCount_;
+  }
+  if (!in.ok() || !in.atEnd()) {
+    clear();
+    return false;
+  }
+
+  ranking.clear();
+  ungraded.clear();
+  for (auto& group: groupGrades) {
+    group.second.ranking.clear();
+    group.second.ungraded.clear();
+  }
+  for (const auto& it: students) {
+    student::Student& student = *it.second;
+    student.averageGrade_ = averageOf(GradeTotals{student.gradeSum_, student.gradeCount_});
+    rankStudent(student);
+  }
+
+  nextId = savedNextId;
+  storeGeneration = generation;
+  return true;
+}
+
 void gavrilova::StudentDatabase::clear()
 {
   students.clear();
   groups.clear();
+  groupGrades.clear();
   nameToStudentIndex.clear();
-  dateToGradesIndex.clear();
+  gradeTable.clear();
+  dateGrades.clear();
+  ranking.clear();
+  ungraded.clear();
+  log({journal::Op::clear});
 }
 
 bool gavrilova::StudentDatabase::createGroup(const std::string& groupName)
 {
-  return groups.emplace(groupName, Group{}).second;
+  groupGrades.emplace(groupName, GroupGrades{});
+  if (!groups.emplace(groupName, Group{}).second) {
+    return false;
+  }
+  log({journal::Op::createGroup, 0, "", groupName});
+  return true;
 }
 
 bool gavrilova::StudentDatabase::groupExists(const std::string& groupName) const
@@ -275,12 +529,22 @@ std::pair< bool, gavrilova::StudentID > gavrilova::StudentDatabase::addStudent
     }
   }
 
-  auto student = std::make_shared< student::Student >(nextId, fullName, groupName);
-  students[nextId] = student;
-  groups[groupName][nextId] = student;
-  nameToStudentIndex[fullName].insert(nextId);
+  StudentID id = nextId;
+  insertStudent(id, fullName, groupName);
+  log({journal::Op::addStudent, id, fullName, groupName});
+
+  return {true, id};
+}
 
-  return {true, nextId++};
+void gavrilova::StudentDatabase::insertStudent(StudentID id, const std::string& fullName,
+    const std::string& groupName)
+{
+  auto student = std::make_shared< student::Student >(id, fullName, groupName);
+  students[id] = student;
+  groups[groupName][id] = student;
+  nameToStudentIndex[fullName].insert(id);
+  rankStudent(*student);
+  nextId = std::max(nextId, id + 1);
 }
 
 bool gavrilova::StudentDatabase::deleteStudent(StudentID id)
@@ -291,34 +555,13 @@ bool gavrilova::StudentDatabase::deleteStudent(StudentID id)
   }
   const auto& student = it_student->second;
 
-  struct GradeRemoverFromDateIndex {
-    struct IsStudentGrade {
-      StudentID studentId;
-      bool operator()(const std::pair< StudentID, int >& p) const
-      {
-        return p.first == studentId;
-      }
-    };
-    StudentID studentIdToRemove;
-    std::map< date::Date, std::vector< std::pair< StudentID, int > > >* dateIndex;
-
-    void operator()(const std::pair< const date::Date, int >& gradeEntry)
-    {
-      auto it_date = dateIndex->find(gradeEntry.first);
-      if (it_date != dateIndex->end()) {
-        auto& gradesOnDate = it_date->second;
-        auto newEnd = std::remove_if(gradesOnDate.begin(), gradesOnDate.end(), IsStudentGrade{studentIdToRemove});
-        gradesOnDate.erase(newEnd, gradesOnDate.end());
-
-        if (gradesOnDate.empty()) {
-          dateIndex->erase(it_date);
-        }
-      }
-    }
-  };
-
-  std::for_each(student->grades_.begin(), student->grades_.end(),
-      GradeRemoverFromDateIndex{id, &dateToGradesIndex});
+  unrankStudent(*student);
+  GroupGrades& group = groupGrades.at(student->group_);
+  for (size_t row = gradeTable.first(id); row != GradeTable::npos; row = gradeTable.first(id)) {
+    uncountGrade(dateGrades, gradeTable.date(row), gradeTable.grade(row));
+    uncountGrade(group.byDate, gradeTable.date(row), gradeTable.grade(row));
+    gradeTable.erase(row);
+  }
 
   groups.at(student->group_).erase(id);
 
@@ -328,19 +571,31 @@ bool gavrilova::StudentDatabase::deleteStudent(StudentID id)
     nameToStudentIndex.erase(student->fullName_);
   }
   students.erase(it_student);
+  log({journal::Op::deleteStudent, id});
   return true;
 }
 
 bool gavrilova::StudentDatabase::moveStudentToGroup(StudentID id, const std::string& newGroupName)
 {
-  auto student_ptr = findStudentById(id);
-  if (!student_ptr || !groupExists(newGroupName) || student_ptr->group_ == newGroupName) {
+  auto it_student = students.find(id);
+  if (it_student == students.end() || !groupExists(newGroupName) || it_student->second->group_ == newGroupName) {
     return false;
   }
+  auto student_ptr = it_student->second;
+
+  unrankStudent(*student_ptr);
+  GroupGrades& from = groupGrades.at(student_ptr->group_);
+  GroupGrades& to = groupGrades.at(newGroupName);
+  for (size_t row = gradeTable.first(id); row != GradeTable::npos; row = gradeTable.next(row)) {
+    uncountGrade(from.byDate, gradeTable.date(row), gradeTable.grade(row));
+    countGrade(to.byDate, gradeTable.date(row), gradeTable.grade(row));
+  }
 
   groups.at(student_ptr->group_).erase(id);
   groups[newGroupName][id] = student_ptr;
   student_ptr->group_ = newGroupName;
+  rankStudent(*student_ptr);
+  log({journal::Op::moveStudent, id, "", newGroupName});
 
   return true;
 }
@@ -351,12 +606,6 @@ std::shared_ptr< const gavrilova::student::Student > gavrilova::StudentDatabase:
   return (it != students.end()) ? it->second : nullptr;
 }
 
-std::shared_ptr< gavrilova::student::Student > gavrilova::StudentDatabase::findStudentById(StudentID id)
-{
-  auto it = students.find(id);
-  return (it != students.end()) ? it->second : nullptr;
-}
-
 std::vector< gavrilova::StudentID > gavrilova::StudentDatabase::findStudentsByName(const std::string& fullName) const
 {
   auto it = nameToStudentIndex.find(fullName);
@@ -371,96 +620,100 @@ std::vector< gavrilova::StudentID > gavrilova::StudentDatabase::findStudentsByNa
 
 bool gavrilova::StudentDatabase::addGrade(StudentID id, int grade, const date::Date& date)
 {
-  auto student_ptr = findStudentById(id);
-
-  if (!student_ptr || student_ptr->grades_.count(date)) {
+  auto it_student = students.find(id);
+  if (it_student == students.end() || gradeTable.find(id, date) != GradeTable::npos) {
     return false;
   }
+  student::Student& student = *it_student->second;
 
-  student_ptr->grades_[date] = grade;
-  dateToGradesIndex[date].push_back({id, grade});
-  updateStudentAverageGrade(student_ptr);
+  gradeTable.insert(id, date, grade);
+  countGrade(dateGrades, date, grade);
+  countGrade(groupGrades.at(student.group_).byDate, date, grade);
+  setGradeTotals(student, student.gradeSum_ + grade, student.gradeCount_ + 1);
+  log({journal::Op::addGrade, id, "", "", date, grade});
 
   return true;
 }
 
 bool gavrilova::StudentDatabase::changeGrade(StudentID id, int newGrade, const date::Date& date)
 {
-  auto student_ptr = findStudentById(id);
-
-  if (!student_ptr || !student_ptr->grades_.count(date)) {
+  auto it_student = students.find(id);
+  size_t row = gradeTable.find(id, date);
+  if (it_student == students.end() || row == GradeTable::npos) {
     return false;
   }
-  student_ptr->grades_[date] = newGrade;
-
-  struct GradeChanger {
-    int newGrade;
-    void operator()(std::pair< StudentID, int >& p) const
-    {
-      p.second = newGrade;
-    }
-  };
-
-  struct FindGradePredicate {
-    StudentID studentId;
-    bool operator()(const std::pair< StudentID, int >& p) const
-    {
-      return p.first == studentId;
-    }
-  };
-
-  auto& grades_on_date = dateToGradesIndex.at(date);
-  auto it_grade = std::find_if(grades_on_date.begin(), grades_on_date.end(), FindGradePredicate{id});
-  if (it_grade != grades_on_date.end()) {
-    GradeChanger{newGrade}(*it_grade);
-  }
+  student::Student& student = *it_student->second;
+  GroupGrades& group = groupGrades.at(student.group_);
+  int oldGrade = gradeTable.grade(row);
+
+  gradeTable.setGrade(row, newGrade);
+  uncountGrade(dateGrades, date, oldGrade);
+  uncountGrade(group.byDate, date, oldGrade);
+  countGrade(dateGrades, date, newGrade);
+  countGrade(group.byDate, date, newGrade);
+  setGradeTotals(student, student.gradeSum_ - oldGrade + newGrade, student.gradeCount_);
+  log({journal::Op::changeGrade, id, "", "", date, newGrade});
 
-  updateStudentAverageGrade(student_ptr);
   return true;
 }
 
 bool gavrilova::StudentDatabase::removeGradesByDate(StudentID id, const date::Date& date)
 {
-  auto student_ptr = findStudentById(id);
-  if (!student_ptr || !student_ptr->grades_.count(date)) {
+  auto it_student = students.find(id);
+  size_t row = gradeTable.find(id, date);
+  if (it_student == students.end() || row == GradeTable::npos) {
     return false;
   }
-  student_ptr->grades_.erase(date);
+  student::Student& student = *it_student->second;
+  int grade = gradeTable.grade(row);
 
-  struct IsStudentGrade {
-    StudentID studentId;
-    bool operator()(const std::pair< StudentID, int >& p) const
-    {
-      return p.first == studentId;
-    }
-  };
-
-  auto it_date = dateToGradesIndex.find(date);
-  if (it_date != dateToGradesIndex.end()) {
-    auto& grades_on_date = it_date->second;
-    auto new_end = std::remove_if(grades_on_date.begin(), grades_on_date.end(), IsStudentGrade{id});
-    grades_on_date.erase(new_end, grades_on_date.end());
-    if (grades_on_date.empty()) {
-      dateToGradesIndex.erase(it_date);
-    }
-  }
+  gradeTable.erase(row);
+  uncountGrade(dateGrades, date, grade);
+  uncountGrade(groupGrades.at(student.group_).byDate, date, grade);
+  setGradeTotals(student, student.gradeSum_ - grade, student.gradeCount_ - 1);
+  log({journal::Op::removeGrade, id, "", "", date});
 
-  updateStudentAverageGrade(student_ptr);
   return true;
 }
 
-void gavrilova::StudentDatabase::updateStudentAverageGrade(std::shared_ptr< student::Student >& student)
+void gavrilova::StudentDatabase::rankStudent(const student::Student& student)
+{
+  rankIn(ranking, ungraded, student);
+  GroupGrades& group = groupGrades.at(student.group_);
+  rankIn(group.ranking, group.ungraded, student);
+}
+
+void gavrilova::StudentDatabase::unrankStudent(const student::Student& student)
+{
+  unrankIn(ranking, ungraded, student);
+  GroupGrades& group = groupGrades.at(student.group_);
+  unrankIn(group.ranking, group.ungraded, student);
+}
+
+void gavrilova::StudentDatabase::setGradeTotals(student::Student& student, long long sum, size_t count)
 {
-  if (student->grades_.empty()) {
-    student->averageGrade_ = 0.0;
+  double average = averageOf(GradeTotals{sum, count});
+  if (student.gradeCount_ && count && student.averageGrade_ == average) {
+    student.gradeSum_ = sum;
+    student.gradeCount_ = count;
     return;
   }
+  unrankStudent(student);
+  student.gradeSum_ = sum;
+  student.gradeCount_ = count;
+  student.averageGrade_ = average;
+  rankStudent(student);
+}
 
-  double sum = 0.0;
-  for (const auto& grade: student->grades_) {
-    sum += grade.second;
+std::vector< std::shared_ptr< const gavrilova::student::Student > >
+gavrilova::StudentDatabase::toStudents(const std::vector< StudentID >& ids) const
+{
+  std::vector< std::shared_ptr< const student::Student > > result;
+  result.reserve(ids.size());
+  for (StudentID id: ids) {
+    result.push_back(students.at(id));
   }
-  student->averageGrade_ = sum / student->grades_.size();
+  return result;
 }
 
 std::vector< std::shared_ptr< const gavrilova::student::Student > >
@@ -520,42 +773,21 @@ bool gavrilova::StudentDatabase::loadGradesFromFile(const std::string& groupName
 std::pair< bool, gavrilova::GroupStatistics > gavrilova::StudentDatabase::getGroupStatistics
     (const std::string& groupName, const DateRange& period) const
 {
-  auto it = groups.find(groupName);
-  if (it == groups.end()) return {false, {}};
+  auto it = groupGrades.find(groupName);
+  if (it == groupGrades.end()) return {false, {}};
+  const GroupGrades& group = it->second;
 
   GroupStatistics stats;
-  std::vector< int > groupGrades;
-  std::vector< std::shared_ptr< const student::Student > > groupStudents;
-
-  std::transform(it->second.begin(), it->second.end(),
-      std::back_inserter(groupStudents),
-      PairToSecond< Group::value_type >());
-
-  std::for_each(groupStudents.begin(), groupStudents.end(),
-      GroupStatsAccumulator{period, groupGrades, stats.gradeDistribution});
-
-  if (!groupGrades.empty()) {
-    stats.groupAverage = std::accumulate(groupGrades.begin(), groupGrades.end(), 0.0) / groupGrades.size();
-  }
-
-  size_t top_count = std::min(static_cast< size_t >(3), groupStudents.size());
-  stats.topStudents.resize(top_count);
-  std::partial_sort_copy(groupStudents.begin(), groupStudents.end(),
-      stats.topStudents.begin(), stats.topStudents.end(),
-      CompareStudentsByGrade{});
+  DateGrades groupPeriod = sumPeriod(group.byDate, period);
+  DateGrades allPeriod = sumPeriod(dateGrades, period);
 
-  stats.bottomStudents.resize(top_count);
-  std::partial_sort_copy(groupStudents.begin(), groupStudents.end(),
-      stats.bottomStudents.begin(), stats.bottomStudents.end(),
-      CompareStudentsByGradeAsc{});
+  stats.gradeDistribution = std::move(groupPeriod.distribution);
+  stats.groupAverage = averageOf(groupPeriod.totals);
+  GradeTotals others{allPeriod.totals.sum - groupPeriod.totals.sum, allPeriod.totals.count - groupPeriod.totals.count};
+  stats.allOtherGroupsAverage = averageOf(others);
 
-  std::vector< int > otherGrades;
-  std::for_each(groups.begin(), groups.end(),
-      OtherGroupsGradesCollector{period, groupName, otherGrades});
-
-  if (!otherGrades.empty()) {
-    stats.allOtherGroupsAverage = std::accumulate(otherGrades.begin(), otherGrades.end(), 0.0) / otherGrades.size();
-  }
+  stats.topStudents = toStudents(topIds(group.ranking, group.ungraded, 3));
+  stats.bottomStudents = toStudents(bottomIds(group.ranking, group.ungraded, 3));
 
   return {true, stats};
 }
@@ -563,71 +795,39 @@ std::pair< bool, gavrilova::GroupStatistics > gavrilova::StudentDatabase::getGro
 std::vector< std::shared_ptr< const gavrilova::student::Student > >
 gavrilova::StudentDatabase::getTopStudents(size_t n) const
 {
-  std::vector< std::shared_ptr< const student::Student > > allStudents;
-  std::transform(students.begin(), students.end(),
-      std::back_inserter(allStudents),
-      PairToSecond< std::map< StudentID, std::shared_ptr< student::Student > >::value_type >());
-
-  std::vector< std::shared_ptr< const student::Student > > result;
-  result.resize(std::min(n, allStudents.size()));
-
-  std::partial_sort_copy(allStudents.begin(), allStudents.end(),
-      result.begin(), result.end(),
-      CompareStudentsByGrade{});
-
-  return result;
+  return toStudents(topIds(ranking, ungraded, n));
 }
 
 std::vector< std::shared_ptr< const gavrilova::student::Student > >
 gavrilova::StudentDatabase::getRiskStudents(double threshold) const
 {
-  std::vector< std::pair< StudentID, std::shared_ptr< student::Student > > > temp;
-  std::copy_if(students.begin(), students.end(),
-      std::back_inserter(temp),
-      IsRiskStudentPredicate{threshold});
-
-  std::vector< std::shared_ptr< const student::Student > > result;
-  std::transform(temp.begin(), temp.end(),
-      std::back_inserter(result),
-      PairToSecond< std::pair< StudentID, std::shared_ptr< student::Student > > >());
-
-  return result;
+  return toStudents(riskIds(ranking, threshold));
 }
 
 std::vector< std::shared_ptr< const gavrilova::student::Student > >
 gavrilova::StudentDatabase::getTopStudentsInGroup(const std::string& groupName, size_t n) const
 {
-  auto students = getStudentsInGroup(groupName);
-  std::vector< std::shared_ptr< const student::Student > > result;
-  result.resize(std::min(n, students.size()));
-
-  std::partial_sort_copy(students.begin(), students.end(),
-      result.begin(), result.end(),
-      CompareStudentsByGrade{});
-
-  return result;
+  auto it = groupGrades.find(groupName);
+  if (it == groupGrades.end()) {
+    return {};
+  }
+  return toStudents(topIds(it->second.ranking, it->second.ungraded, n));
 }
 
 std::vector< std::shared_ptr< const gavrilova::student::Student > >
 gavrilova::StudentDatabase::getRiskStudentsInGroup(const std::string& groupName, double threshold) const
 {
-  auto students = getStudentsInGroup(groupName);
-  std::vector< std::shared_ptr< const student::Student > > result;
-  std::copy_if(students.begin(), students.end(),
-      std::back_inserter(result),
-      IsRiskStudentInGroupPredicate{threshold});
-
-  return result;
+  auto it = groupGrades.find(groupName);
+  if (it == groupGrades.end()) {
+    return {};
+  }
+  return toStudents(riskIds(it->second.ranking, threshold));
 }
 
 std::pair< bool, double > gavrilova::StudentDatabase::getAverageGradeByDate(const date::Date& date) const
 {
-  auto it = dateToGradesIndex.find(date);
-  if (it == dateToGradesIndex.end()) return {false, 0.0};
-
-  const auto& grades = it->second;
-  double sum = std::accumulate(grades.begin(), grades.end(), 0.0,
-      GradePairAccumulator{});
+  auto it = dateGrades.find(date);
+  if (it == dateGrades.end()) return {false, 0.0};
 
-  return {true, sum / grades.size()};
+  return {true, averageOf(it->second.totals)};
 }
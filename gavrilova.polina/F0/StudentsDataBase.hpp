@@ -9,6 +9,8 @@
 #include <string>
 #include <vector>
 #include "Date.hpp"
+#include "GradeTable.hpp"
+#include "Journal.hpp"
 #include "Student.hpp"
 
 namespace gavrilova {
@@ -26,6 +28,33 @@ namespace gavrilova {
     double allOtherGroupsAverage = 0.0;
   };
 
+  struct GradeTotals {
+    long long sum = 0;
+    size_t count = 0;
+  };
+
+  struct DateGrades {
+    GradeTotals totals;
+    std::map< int, int > distribution;
+  };
+
+  struct RankKey {
+    double average;
+    StudentID id;
+  };
+
+  struct RankOrder {
+    bool operator()(const RankKey& a, const RankKey& b) const;
+  };
+
+  using Ranking = std::set< RankKey, RankOrder >;
+
+  struct GroupGrades {
+    Ranking ranking;
+    std::set< StudentID > ungraded;
+    std::map< date::Date, DateGrades > byDate;
+  };
+
   class StudentDatabase {
   public:
     using Group = std::map< StudentID, std::shared_ptr< student::Student > >;
@@ -34,6 +63,8 @@ namespace gavrilova {
 
     bool saveToFile(const std::string& filename) const;
     bool loadFromFile(const std::string& filename);
+    bool openStore(const std::string& path);
+    bool compact();
     void clear();
 
     bool createGroup(const std::string& groupName);
@@ -61,15 +92,29 @@ namespace gavrilova {
     bool exportGroupForGrading(const std::string& groupName, const std::string& filename) const;
     std::pair< bool, GroupStatistics > getGroupStatistics(const std::string& groupName, const DateRange& period) const;
 
-    std::shared_ptr< student::Student > findStudentById(StudentID id);
-    void updateStudentAverageGrade(std::shared_ptr< student::Student >& student);
-
   private:
     std::map< StudentID, std::shared_ptr< student::Student > > students;
     std::map< std::string, Group > groups;
+    std::map< std::string, GroupGrades > groupGrades;
     std::map< std::string, std::set< StudentID > > nameToStudentIndex;
-    std::map< date::Date, std::vector< std::pair< StudentID, int > > > dateToGradesIndex;
+    GradeTable gradeTable;
+    std::map< date::Date, DateGrades > dateGrades;
+    Ranking ranking;
+    std::set< StudentID > ungraded;
     StudentID nextId;
+    journal::Journal journal;
+    std::string storePath;
+    unsigned long long storeGeneration;
+
+    void insertStudent(StudentID id, const std::string& fullName, const std::string& groupName);
+    void log(const journal::Record& record);
+    void apply(const journal::Record& record);
+    bool writeSnapshot(const std::string& path, unsigned long long generation) const;
+    bool readSnapshot(const std::string& path);
+    void rankStudent(const student::Student& student);
+    void unrankStudent(const student::Student& student);
+    void setGradeTotals(student::Student& student, long long sum, size_t count);
+    std::vector< std::shared_ptr< const student::Student > > toStudents(const std::vector< StudentID >& ids) const;
   };
 }
 
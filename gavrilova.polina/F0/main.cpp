@@ -6,7 +6,13 @@ int main(int argc, char* argv[])
 {
   gavrilova::StudentDatabase db;
 
-  if (argc > 1) {
+  if (argc > 2 && std::string(argv[1]) == "--store") {
+    std::cout << "Открытие хранилища: " << argv[2] << '\n';
+    if (!db.openStore(argv[2])) {
+      std::cerr << "Ошибка: не удалось открыть хранилище " << argv[2] << '\n';
+      return 1;
+    }
+  } else if (argc > 1) {
     std::cout << "Загрузка данных из файла: " << argv[1] << '\n';
     if (!db.loadFromFile(argv[1])) {
       std::cerr << "Ошибка: не удалось загрузить данные из файла " << argv[1] << '\n';
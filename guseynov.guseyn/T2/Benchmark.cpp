@@ -0,0 +1,86 @@
+#include "Benchmark.h"
+#include "Pipeline.h"
+#include <chrono>
+#include <sstream>
+#include <iomanip>
+
+namespace
+{
+  using Clock = std::chrono::steady_clock;
+
+  double secondsSince(Clock::time_point start)
+  {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+  }
+
+  double perSecond(double amount, double seconds)
+  {
+    return seconds > 0.0 ? amount / seconds : 0.0;
+  }
+
+  double megabytes(size_t bytes)
+  {
+    return bytes / 1e6;
+  }
+}
+
+std::vector<guseynov::StageResult> guseynov::runBenchmark(const std::string& corpus)
+{
+  std::istringstream in(corpus);
+  Clock::time_point start = Clock::now();
+  std::vector<DataStruct> data = readRecords(in);
+  double parseTime = secondsSince(start);
+
+  start = Clock::now();
+  sortRecords(data);
+  double sortTime = secondsSince(start);
+
+  std::ostringstream out;
+  start = Clock::now();
+  writeRecords(out, data);
+  double emitTime = secondsSince(start);
+  size_t emitted = out.str().size();
+
+  return {
+    {"parse", data.size(), corpus.size(), parseTime},
+    {"sort", data.size(), emitted, sortTime},
+    {"emit", data.size(), emitted, emitTime}
+  };
+}
+
+void guseynov::printResults(std::ostream& out, const std::vector<StageResult>& results)
+{
+  FormatGuard guard(out);
+  out << std::fixed;
+  for (const StageResult& stage: results)
+  {
+    out << std::left << std::setw(6) << stage.name << std::right;
+    out << std::setprecision(3) << std::setw(10) << stage.seconds << " s";
+    out << std::setprecision(0) << std::setw(14) << perSecond(stage.records, stage.seconds) << " records/s";
+    out << std::setprecision(1) << std::setw(10) << perSecond(megabytes(stage.bytes), stage.seconds) << " MB/s\n";
+  }
+}
+
+void guseynov::writeJson(std::ostream& out, const CorpusConfig& config, const std::vector<StageResult>& results)
+{
+  FormatGuard guard(out);
+  out << std::setprecision(6);
+  out << "{\n";
+  out << "  \"records\": " << config.records << ",\n";
+  out << "  \"malformed\": " << config.malformed << ",\n";
+  out << "  \"seed\": " << config.seed << ",\n";
+  out << "  \"stages\": [\n";
+  for (size_t i = 0; i < results.size(); i++)
+  {
+    const StageResult& stage = results[i];
+    out << "    {\"name\": \"" << stage.name << "\"";
+    out << ", \"records\": " << stage.records;
+    out << ", \"bytes\": " << stage.bytes;
+    out << ", \"seconds\": " << stage.seconds;
+    out << ", \"records_per_second\": " << perSecond(stage.records, stage.seconds);
+    out << ", \"mb_per_second\": " << perSecond(megabytes(stage.bytes), stage.seconds) << "}";
+    out << (i + 1 < results.size() ? ",\n" : "\n");
+  }
+  out << "  ]\n";
+  out << "}\n";
+}
@@ -0,0 +1,24 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <string>
+#include <vector>
+#include <iosfwd>
+#include "Generator.h"
+
+namespace guseynov
+{
+  struct StageResult
+  {
+    std::string name;
+    size_t records;
+    size_t bytes;
+    double seconds;
+  };
+
+  std::vector<StageResult> runBenchmark(const std::string& corpus);
+  void printResults(std::ostream& out, const std::vector<StageResult>& results);
+  void writeJson(std::ostream& out, const CorpusConfig& config, const std::vector<StageResult>& results);
+}
+
+#endif
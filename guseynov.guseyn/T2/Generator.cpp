@@ -0,0 +1,131 @@
+#include "Generator.h"
+#include <ostream>
+#include <sstream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+namespace
+{
+  using Engine = std::mt19937_64;
+
+  struct Field
+  {
+    std::string name;
+    std::string value;
+  };
+
+  size_t pick(Engine& engine, size_t count)
+  {
+    return std::uniform_int_distribution<size_t>(0, count - 1)(engine);
+  }
+
+  std::string makeHex(Engine& engine)
+  {
+    std::ostringstream out;
+    out << "0x" << std::hex;
+    if (pick(engine, 2))
+    {
+      out << std::uppercase;
+    }
+    out << (engine() >> pick(engine, 64));
+    return out.str();
+  }
+
+  std::string makeDouble(Engine& engine)
+  {
+    std::ostringstream out;
+    double value = std::uniform_int_distribution<int>(-99999, 99999)(engine) / 100.0;
+    if (pick(engine, 4) == 0)
+    {
+      out << std::scientific << std::setprecision(pick(engine, 4)) << value;
+    }
+    else
+    {
+      out << std::fixed << std::setprecision(pick(engine, 3)) << value;
+    }
+    return out.str();
+  }
+
+  std::string makeComplex(Engine& engine)
+  {
+    return "#c(" + makeDouble(engine) + " " + makeDouble(engine) + ")";
+  }
+
+  std::string makeString(Engine& engine)
+  {
+    static const std::string alphabet = "abcdefghijklmnopqrstuvwxyz ABCXYZ0123456789";
+    std::string result = "\"";
+    for (size_t i = pick(engine, 25); i > 0; i--)
+    {
+      result += alphabet[pick(engine, alphabet.size())];
+    }
+    return result + "\"";
+  }
+
+  std::string makeForeign(Engine& engine)
+  {
+    switch (pick(engine, 6))
+    {
+    case 0:
+      return "0b" + std::to_string(pick(engine, 2)) + "101";
+    case 1:
+      return std::string("'") + static_cast<char>('a' + pick(engine, 26)) + "'";
+    case 2:
+      return "(:N -" + std::to_string(pick(engine, 100)) + ":D " + std::to_string(pick(engine, 100) + 1) + ":)";
+    case 3:
+      return std::to_string(engine() >> 8) + "ull";
+    case 4:
+      return makeDouble(engine) + "d";
+    default:
+      return "0X" + std::to_string(pick(engine, 1000));
+    }
+  }
+
+  void corrupt(std::vector<Field>& fields, Engine& engine)
+  {
+    switch (pick(engine, 4))
+    {
+    case 0:
+      fields[pick(engine, fields.size())].value = makeForeign(engine);
+      break;
+    case 1:
+      fields.back() = fields.front();
+      break;
+    case 2:
+      fields.erase(fields.begin() + pick(engine, fields.size()));
+      break;
+    default:
+      fields[pick(engine, fields.size())].name = "key4";
+      break;
+    }
+  }
+
+  std::string makeRecord(Engine& engine, bool malformed)
+  {
+    std::vector<Field> fields{{"key1", makeHex(engine)}, {"key2", makeComplex(engine)}, {"key3", makeString(engine)}};
+    std::shuffle(fields.begin(), fields.end(), engine);
+    if (malformed)
+    {
+      corrupt(fields, engine);
+    }
+    std::string record = "(";
+    for (const Field& field: fields)
+    {
+      record += ":" + field.name + " " + field.value;
+    }
+    return record + ":)";
+  }
+}
+
+void guseynov::generateCorpus(std::ostream& out, const CorpusConfig& config)
+{
+  Engine engine(config.seed);
+  std::bernoulli_distribution malformed(config.malformed);
+  for (size_t i = 0; i < config.records; i++)
+  {
+    out << makeRecord(engine, malformed(engine)) << '\n';
+  }
+}
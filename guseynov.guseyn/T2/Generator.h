@@ -0,0 +1,19 @@
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include <cstddef>
+#include <iosfwd>
+
+namespace guseynov
+{
+  struct CorpusConfig
+  {
+    size_t records = 100000;
+    double malformed = 0.0;
+    unsigned long long seed = 1;
+  };
+
+  void generateCorpus(std::ostream& out, const CorpusConfig& config);
+}
+
+#endif
@@ -0,0 +1,32 @@
+#include "Pipeline.h"
+#include <iostream>
+#include <iterator>
+#include <algorithm>
+#include <limits>
+
+std::vector<guseynov::DataStruct> guseynov::readRecords(std::istream& in)
+{
+  using input_it_t = std::istream_iterator<DataStruct>;
+  std::vector<DataStruct> data;
+  while (!in.eof())
+  {
+    std::copy(input_it_t{in}, input_it_t{}, std::back_inserter(data));
+    if (in.fail())
+    {
+      in.clear();
+      in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    }
+  }
+  return data;
+}
+
+void guseynov::sortRecords(std::vector<DataStruct>& data)
+{
+  std::sort(data.begin(), data.end());
+}
+
+void guseynov::writeRecords(std::ostream& out, const std::vector<DataStruct>& data)
+{
+  using output_it_t = std::ostream_iterator<DataStruct>;
+  std::copy(data.cbegin(), data.cend(), output_it_t{out, "\n"});
+}
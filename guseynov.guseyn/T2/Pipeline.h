@@ -0,0 +1,15 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <vector>
+#include <iosfwd>
+#include "DataStruct.h"
+
+namespace guseynov
+{
+  std::vector<DataStruct> readRecords(std::istream& in);
+  void sortRecords(std::vector<DataStruct>& data);
+  void writeRecords(std::ostream& out, const std::vector<DataStruct>& data);
+}
+
+#endif
@@ -1,30 +1,101 @@
 #include "DataStruct.h"
+#include "Pipeline.h"
+#include "Generator.h"
+#include "Benchmark.h"
 #include <iostream>
-#include <iterator>
-#include <vector>
-#include <algorithm>
-#include <limits>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <stdexcept>
 
-int main()
+namespace
 {
-  using guseynov::DataStruct;
-  using input_it_t = std::istream_iterator<DataStruct>;
-  using output_it_t = std::ostream_iterator<DataStruct>;
+  bool parseOptions(int argc, char* argv[], guseynov::CorpusConfig& config, std::string& jsonFile)
+  {
+    for (int i = 2; i < argc; i += 2)
+    {
+      std::string option = argv[i];
+      if (i + 1 >= argc)
+      {
+        return false;
+      }
+      std::string value = argv[i + 1];
+      if (option == "--records")
+      {
+        config.records = std::stoull(value);
+      }
+      else if (option == "--malformed")
+      {
+        config.malformed = std::stod(value);
+        if (config.malformed < 0.0 || config.malformed > 1.0)
+        {
+          return false;
+        }
+      }
+      else if (option == "--seed")
+      {
+        config.seed = std::stoull(value);
+      }
+      else if (option == "--json")
+      {
+        jsonFile = value;
+      }
+      else
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+}
 
-  std::vector<DataStruct> data;
+int main(int argc, char* argv[])
+{
+  using namespace guseynov;
+
+  if (argc == 1)
+  {
+    std::vector<DataStruct> data = readRecords(std::cin);
+    sortRecords(data);
+    writeRecords(std::cout, data);
+    return 0;
+  }
 
-  while (!std::cin.eof())
+  std::string mode = argv[1];
+  CorpusConfig config;
+  std::string jsonFile;
+  try
   {
-    std::copy(input_it_t{std::cin}, input_it_t{}, std::back_inserter(data));
-    if (std::cin.fail())
+    if ((mode != "--generate" && mode != "--benchmark") || !parseOptions(argc, argv, config, jsonFile))
     {
-      std::cin.clear();
-      std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+      throw std::invalid_argument("bad arguments");
     }
   }
+  catch (const std::exception&)
+  {
+    std::cerr << "Usage: lab [--generate | --benchmark] [--records N] [--malformed SHARE] [--seed N] [--json FILE]\n";
+    return 1;
+  }
 
-  std::sort(data.begin(), data.end());
-  std::copy(data.cbegin(), data.cend(), output_it_t{std::cout, "\n"});
+  if (mode == "--generate")
+  {
+    generateCorpus(std::cout, config);
+    return 0;
+  }
 
+  std::ostringstream corpus;
+  generateCorpus(corpus, config);
+  std::vector<StageResult> results = runBenchmark(corpus.str());
+  printResults(std::cout, results);
+  if (!jsonFile.empty())
+  {
+    std::ofstream json(jsonFile);
+    writeJson(json, config, results);
+    if (!json)
+    {
+      std::cerr << "Cannot write " << jsonFile << '\n';
+      return 1;
+    }
+  }
   return 0;
 }
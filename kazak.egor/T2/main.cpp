@@ -3,13 +3,42 @@
 #include <iterator>
 #include <limits>
 #include <algorithm>
+#include <cstring>
 #include "datastruct.hpp"
+#include "record_arena.hpp"
 #include "stream_guard.hpp"
 
-int main()
+int main(int argc, char* argv[])
 {
   using namespace kazak;
 
+  bool useArena = argc == 2 && std::strcmp(argv[1], "--arena") == 0;
+  if (argc != 1 && !useArena)
+  {
+    std::cerr << "Usage: lab [--arena]\n";
+    return 1;
+  }
+
+  if (useArena)
+  {
+    RecordArena arena;
+    while (!std::cin.eof())
+    {
+      while (arena.append(std::cin))
+      {}
+
+      if (!std::cin)
+      {
+        std::cin.clear();
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+      }
+    }
+
+    arena.sort();
+    arena.write(std::cout);
+    return 0;
+  }
+
   std::vector< DataStruct > data;
 
   while (!std::cin.eof())
@@ -0,0 +1,146 @@
+#include "record_arena.hpp"
+#include "datastruct.hpp"
+#include "stream_guard.hpp"
+#include <algorithm>
+
+namespace
+{
+  struct IndexLess
+  {
+    const std::vector< kazak::ArenaRecord >& records;
+
+    bool operator()(size_t lhs, size_t rhs) const
+    {
+      const kazak::ArenaRecord& l = records[lhs];
+      const kazak::ArenaRecord& r = records[rhs];
+      if (l.key1 != r.key1)
+      {
+        return l.key1 < r.key1;
+      }
+      if (l.key2 != r.key2)
+      {
+        return l.key2 < r.key2;
+      }
+      return l.length < r.length;
+    }
+  };
+}
+
+std::istream& kazak::operator>>(std::istream& in, ArenaStringIO&& dest)
+{
+  std::istream::sentry sentry(in);
+  if (!sentry)
+  {
+    return in;
+  }
+
+  in >> DelimiterIO{'"'};
+  if (!in)
+  {
+    return in;
+  }
+
+  using traits = std::istream::traits_type;
+  std::streambuf* buf = in.rdbuf();
+  size_t extracted = 0;
+  while (true)
+  {
+    traits::int_type c = buf->sbumpc();
+    if (traits::eq_int_type(c, traits::eof()))
+    {
+      in.setstate(extracted ? std::ios::eofbit : std::ios::eofbit | std::ios::failbit);
+      break;
+    }
+    ++extracted;
+    if (traits::eq_int_type(c, traits::to_int_type('"')))
+    {
+      break;
+    }
+    dest.arena.push_back(traits::to_char_type(c));
+  }
+  return in;
+}
+
+std::istream& kazak::RecordArena::append(std::istream& in)
+{
+  std::istream::sentry sentry(in);
+  if (!sentry)
+  {
+    return in;
+  }
+
+  const size_t mark = bytes_.size();
+  ArenaRecord input{};
+  size_t keyCount = 0;
+
+  in >> DelimiterIO{'('} >> DelimiterIO{':'};
+
+  while (keyCount < 3 && in)
+  {
+    std::string key;
+    in >> key;
+
+    if (key == "key1")
+    {
+      in >> ULLHexIO{input.key1} >> DelimiterIO{':'};
+      ++keyCount;
+    }
+    else if (key == "key2")
+    {
+      in >> RationalIO{input.key2} >> DelimiterIO{':'};
+      ++keyCount;
+    }
+    else if (key == "key3")
+    {
+      bytes_.resize(mark);
+      in >> ArenaStringIO{bytes_} >> DelimiterIO{':'};
+      input.offset = mark;
+      input.length = bytes_.size() - mark;
+      ++keyCount;
+    }
+    else
+    {
+      in.setstate(std::ios::failbit);
+    }
+  }
+
+  in >> DelimiterIO{')'};
+
+  if (in)
+  {
+    order_.push_back(records_.size());
+    records_.push_back(input);
+  }
+  else
+  {
+    bytes_.resize(mark);
+  }
+
+  return in;
+}
+
+void kazak::RecordArena::sort()
+{
+  std::sort(order_.begin(), order_.end(), IndexLess{records_});
+}
+
+void kazak::RecordArena::write(std::ostream& out) const
+{
+  std::ostream::sentry sentry(out);
+  if (!sentry)
+  {
+    return;
+  }
+
+  StreamGuard guard(out);
+  out << std::uppercase;
+  for (size_t i: order_)
+  {
+    const ArenaRecord& src = records_[i];
+    out << "(:key1 0x" << std::hex << src.key1;
+    out << ":key2 (:N " << std::dec << src.key2.first << ":D " << src.key2.second << ":)";
+    out << ":key3 \"";
+    out.write(bytes_.data() + src.offset, src.length);
+    out << "\":)\n";
+  }
+}
@@ -0,0 +1,37 @@
+#ifndef RECORD_ARENA_HPP
+#define RECORD_ARENA_HPP
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace kazak
+{
+  struct ArenaRecord
+  {
+    unsigned long long key1;
+    std::pair< long long, unsigned long long > key2;
+    size_t offset;
+    size_t length;
+  };
+
+  struct ArenaStringIO
+  {
+    std::string& arena;
+  };
+
+  class RecordArena
+  {
+  public:
+    std::istream& append(std::istream& in);
+    void sort();
+    void write(std::ostream& out) const;
+  private:
+    std::string bytes_;
+    std::vector< ArenaRecord > records_;
+    std::vector< size_t > order_;
+  };
+
+  std::istream& operator>>(std::istream& in, ArenaStringIO&& dest);
+}
+
+#endif
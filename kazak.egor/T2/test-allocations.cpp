@@ -0,0 +1,133 @@
+#define BOOST_TEST_MODULE kazak_t2_allocations
+#include <boost/test/included/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "datastruct.hpp"
+#include "record_arena.hpp"
+
+namespace
+{
+  size_t allocations = 0;
+
+  std::string makeInput(size_t count, unsigned seed)
+  {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution< unsigned long long > key1(0, 0xFFFFF);
+    std::uniform_int_distribution< long long > numerator(-1000, 1000);
+    std::uniform_int_distribution< unsigned long long > denominator(1, 1000);
+    std::uniform_int_distribution< size_t > length(0, 40);
+    std::uniform_int_distribution< int > letter('a', 'z');
+    std::uniform_int_distribution< int > broken(0, 49);
+    std::ostringstream out;
+    for (size_t i = 0; i < count; ++i)
+    {
+      std::string key3(length(generator), ' ');
+      for (auto it = key3.begin(); it != key3.end(); ++it)
+      {
+        *it = static_cast< char >(letter(generator));
+      }
+      std::ostringstream record;
+      record << "(:key1 0x" << std::hex << std::uppercase << key1(generator) << std::dec;
+      record << ":key2 (:N " << numerator(generator) << ":D " << denominator(generator) << ":)";
+      record << ":key3 \"" << key3 << "\":)";
+      std::string line = record.str();
+      if (broken(generator) == 0)
+      {
+        line.resize(line.size() / 2);
+      }
+      out << line << '\n';
+    }
+    return out.str();
+  }
+
+  std::string sortDefault(const std::string& input, size_t& parseAllocations)
+  {
+    std::istringstream in(input);
+    std::vector< kazak::DataStruct > data;
+    size_t before = allocations;
+    while (!in.eof())
+    {
+      std::copy(std::istream_iterator< kazak::DataStruct >(in), std::istream_iterator< kazak::DataStruct >(), std::back_inserter(data));
+      if (!in)
+      {
+        in.clear();
+        in.ignore(std::numeric_limits< std::streamsize >::max(), '\n');
+      }
+    }
+    std::sort(data.begin(), data.end());
+    parseAllocations = allocations - before;
+    std::ostringstream out;
+    std::copy(data.begin(), data.end(), std::ostream_iterator< kazak::DataStruct >(out, "\n"));
+    return out.str();
+  }
+
+  std::string sortArena(const std::string& input, size_t& parseAllocations)
+  {
+    std::istringstream in(input);
+    kazak::RecordArena arena;
+    size_t before = allocations;
+    while (!in.eof())
+    {
+      while (arena.append(in))
+      {}
+      if (!in)
+      {
+        in.clear();
+        in.ignore(std::numeric_limits< std::streamsize >::max(), '\n');
+      }
+    }
+    arena.sort();
+    parseAllocations = allocations - before;
+    std::ostringstream out;
+    arena.write(out);
+    return out.str();
+  }
+}
+
+void* operator new(size_t size)
+{
+  ++allocations;
+  void* ptr = std::malloc(size ? size : 1);
+  if (!ptr)
+  {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+  std::free(ptr);
+}
+
+BOOST_AUTO_TEST_CASE(arena_matches_default)
+{
+  for (unsigned seed = 0; seed < 50; ++seed)
+  {
+    std::string input = makeInput(200, seed);
+    size_t unused = 0;
+    BOOST_REQUIRE_EQUAL(sortDefault(input, unused), sortArena(input, unused));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(arena_allocations_do_not_grow_per_record)
+{
+  const size_t count = 20000;
+  std::string input = makeInput(count, 35);
+  size_t arenaAllocations = 0;
+  sortArena(input, arenaAllocations);
+  BOOST_CHECK_LT(arenaAllocations * 100, count);
+}
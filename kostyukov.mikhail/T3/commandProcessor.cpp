@@ -4,15 +4,16 @@
 
 kostyukov::CommandProcessor::CommandProcessor(PolygonContainer& polygons, std::istream& in, std::ostream& out):
   polygons_(polygons),
+  store_(polygons),
   in_(in),
   out_(out)
 {
-  add("AREA", area);
+  commands_["AREA"] = std::bind(area, std::ref(in_), std::ref(out_), std::cref(store_));
   add("MAX", max);
   add("MIN", min);
   add("COUNT", count);
   add("PERMS", permsCount);
-  commands_["RIGHTSHAPES"] = std::bind(rightShapesCount, std::ref(out_), std::cref(polygons));
+  commands_["RIGHTSHAPES"] = std::bind(rightShapesCount, std::ref(out_), std::cref(store_));
 }
 
 void kostyukov::CommandProcessor::add(const std::string& commandName, CommandFunc func)
@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "geometry.hpp"
+#include "polygonStore.hpp"
 
 namespace kostyukov
 {
@@ -23,6 +24,7 @@ namespace kostyukov
       void add(const std::string& commandName, CommandFunc func);
       std::map< std::string, std::function< void() > > commands_;
       PolygonContainer& polygons_;
+      PolygonStore store_;
       std::istream& in_;
       std::ostream& out_;
   };
@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "geometry.hpp"
+#include "polygonStore.hpp"
 #include "scopeGuard.hpp"
 
 namespace
@@ -35,52 +36,75 @@ namespace
     return std::is_permutation(polygon1.points.cbegin(), polygon1.points.cend(), polygon2.points.cbegin());
   }
 
-  bool forAll(const kostyukov::Polygon&)
+  struct VertexExpected
+  {
+    size_t count;
+    bool operator()(const kostyukov::Polygon& polygon) const
+    {
+      return polygon.points.size() == count;
+    }
+  };
+
+  bool isEvenCount(size_t countVertexes)
+  {
+    return countVertexes % 2 == 0;
+  }
+
+  bool isOddCount(size_t countVertexes)
+  {
+    return !isEvenCount(countVertexes);
+  }
+
+  bool forAllCounts(size_t)
   {
     return true;
   }
 
-  struct VertexExpected
+  struct VertexCountExpected
   {
     size_t count;
-    bool operator()(const kostyukov::Polygon& polygon) const
+    bool operator()(size_t countVertexes) const
     {
-      return polygon.points.size() == count;
+      return countVertexes == count;
     }
   };
 
   template< typename Parameter >
-  double sumAreasIf(const std::vector< kostyukov::Polygon >& polygons, Parameter param)
+  double sumAreasIf(const kostyukov::PolygonStore& store, Parameter param)
   {
-    std::vector< kostyukov::Polygon > suitablePolygons;
-    std::copy_if(polygons.begin(), polygons.end(), std::back_inserter(suitablePolygons), param);
-    std::vector< double > areas;
-    std::transform(suitablePolygons.begin(), suitablePolygons.end(), std::back_inserter(areas), kostyukov::getArea);
-    return std::accumulate(areas.begin(), areas.end(), 0.0);
+    double result = 0.0;
+    for (size_t i = 0; i < store.size(); ++i)
+    {
+      if (param(store.vertexes(i)))
+      {
+        result += store.area(i);
+      }
+    }
+    return result;
   }
 
-  double areaForEven(const std::vector< kostyukov::Polygon >& polygons)
+  double areaForEven(const kostyukov::PolygonStore& store)
   {
-    return sumAreasIf(polygons, isEven);
+    return sumAreasIf(store, isEvenCount);
   }
 
-  double areaForOdd(const std::vector< kostyukov::Polygon >& polygons)
+  double areaForOdd(const kostyukov::PolygonStore& store)
   {
-    return sumAreasIf(polygons, isOdd);
+    return sumAreasIf(store, isOddCount);
   }
 
-  double areaForNum(const std::vector< kostyukov::Polygon >& polygons, size_t countVertexes)
+  double areaForNum(const kostyukov::PolygonStore& store, size_t countVertexes)
   {
-    return sumAreasIf(polygons, VertexExpected{ countVertexes });
+    return sumAreasIf(store, VertexCountExpected{ countVertexes });
   }
 
-  double meanArea(const std::vector< kostyukov::Polygon >& polygons)
+  double meanArea(const kostyukov::PolygonStore& store)
   {
-    if (polygons.empty())
+    if (store.size() == 0)
     {
       throw std::invalid_argument("no polygons for mean area");
     }
-    return sumAreasIf(polygons, forAll) / polygons.size();
+    return sumAreasIf(store, forAllCounts) / store.size();
   }
 
   template < typename Parameter >
@@ -143,46 +167,17 @@ namespace
     out << minPolygon.points.size();
     return;
   }
-
-  struct RightAnglesInspector
-  {
-    const kostyukov::Polygon& polygon;
-    bool operator()(size_t number) const
-    {
-      size_t countVertexes = polygon.points.size();
-      const kostyukov::Point& previous = polygon.points[(number + countVertexes - 1) % countVertexes];
-      const kostyukov::Point& current = polygon.points[number];
-      const kostyukov::Point& next = polygon.points[(number + 1) % countVertexes];
-      double vector1_x = current.x - previous.x;
-      double vector1_y = current.y - previous.y;
-      double vector2_x = next.x - current.x;
-      double vector2_y = next.y - current.y;
-      double scalarProduct = vector1_x * vector2_x + vector1_y * vector2_y;
-      return scalarProduct == 0;
-    }
-  };
-
-  bool hasRightAngles(const kostyukov::Polygon& polygon)
-  {
-    if (polygon.points.size() < 3)
-    {
-      return false;
-    }
-    std::vector< size_t > numbers(polygon.points.size());
-    std::iota(numbers.begin(), numbers.end(), 0);
-    return std::any_of(numbers.begin(), numbers.end(), RightAnglesInspector{ polygon });
-  }
 }
 
-void kostyukov::area(std::istream& in, std::ostream& out, const std::vector< Polygon >& polygons)
+void kostyukov::area(std::istream& in, std::ostream& out, const PolygonStore& store)
 {
   std::unordered_map< std::string, std::function< double() > > subcommands;
   std::string subcommand;
   in >> subcommand;
   double result = 0.0;
-  subcommands["EVEN"] = std::bind(areaForEven, std::cref(polygons));
-  subcommands["ODD"] = std::bind(areaForOdd, std::cref(polygons));
-  subcommands["MEAN"] = std::bind(meanArea, std::cref(polygons));
+  subcommands["EVEN"] = std::bind(areaForEven, std::cref(store));
+  subcommands["ODD"] = std::bind(areaForOdd, std::cref(store));
+  subcommands["MEAN"] = std::bind(meanArea, std::cref(store));
 
   try
   {
@@ -195,7 +190,7 @@ void kostyukov::area(std::istream& in, std::ostream& out, const std::vector< Pol
     {
       throw std::invalid_argument("number of vertexes must be 3 or greater");
     }
-    result = areaForNum(polygons, countVertexes);
+    result = areaForNum(store, countVertexes);
   }
 
   ScopeGuard scopeGrd(out);
@@ -280,8 +275,13 @@ void kostyukov::permsCount(std::istream& in, std::ostream& out, const std::vecto
   return;
 }
 
-void kostyukov::rightShapesCount(std::ostream& out, const std::vector< Polygon >& polygons)
+void kostyukov::rightShapesCount(std::ostream& out, const PolygonStore& store)
 {
-  out << std::count_if(polygons.cbegin(), polygons.cend(), hasRightAngles);
+  size_t result = 0;
+  for (size_t i = 0; i < store.size(); ++i)
+  {
+    result += store.hasRightAngle(i);
+  }
+  out << result;
   return;
 }
@@ -4,14 +4,15 @@
 #include <vector>
 
 #include "geometry.hpp"
+#include "polygonStore.hpp"
 
 namespace kostyukov
 {
-  void area(std::istream&, std::ostream&, const std::vector< Polygon >&);
+  void area(std::istream&, std::ostream&, const PolygonStore&);
   void max(std::istream&, std::ostream&, const std::vector< Polygon >&);
   void min(std::istream&, std::ostream&, const std::vector< Polygon >&);
   void count(std::istream&, std::ostream&, const std::vector< Polygon >&);
   void permsCount(std::istream&, std::ostream&, const std::vector< Polygon >&);
-  void rightShapesCount(std::ostream&, const std::vector< Polygon >&);
+  void rightShapesCount(std::ostream&, const PolygonStore&);
 }
 #endif
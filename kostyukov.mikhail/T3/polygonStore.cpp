@@ -0,0 +1,76 @@
+#include "polygonStore.hpp"
+
+#include <cmath>
+
+kostyukov::PolygonStore::PolygonStore(const std::vector< Polygon >& polygons):
+  x_(),
+  y_(),
+  offsets_(1, 0)
+{
+  offsets_.reserve(polygons.size() + 1);
+  for (auto it = polygons.cbegin(); it != polygons.cend(); ++it)
+  {
+    offsets_.push_back(offsets_.back() + it->points.size());
+  }
+  x_.reserve(offsets_.back());
+  y_.reserve(offsets_.back());
+  for (auto it = polygons.cbegin(); it != polygons.cend(); ++it)
+  {
+    for (auto point = it->points.cbegin(); point != it->points.cend(); ++point)
+    {
+      x_.push_back(point->x);
+      y_.push_back(point->y);
+    }
+  }
+}
+
+size_t kostyukov::PolygonStore::size() const
+{
+  return offsets_.size() - 1;
+}
+
+size_t kostyukov::PolygonStore::vertexes(size_t number) const
+{
+  return offsets_[number + 1] - offsets_[number];
+}
+
+double kostyukov::PolygonStore::area(size_t number) const
+{
+  size_t count = vertexes(number);
+  if (count < 3)
+  {
+    return 0.0;
+  }
+  const int* x = x_.data() + offsets_[number];
+  const int* y = y_.data() + offsets_[number];
+  double result = 0.0;
+  for (size_t i = 0; i < count - 1; ++i)
+  {
+    result += x[i] * y[i + 1] - x[i + 1] * y[i];
+  }
+  result += x[count - 1] * y[0] - x[0] * y[count - 1];
+  return std::abs(result) / 2.0;
+}
+
+bool kostyukov::PolygonStore::hasRightAngle(size_t number) const
+{
+  size_t count = vertexes(number);
+  if (count < 3)
+  {
+    return false;
+  }
+  const int* x = x_.data() + offsets_[number];
+  const int* y = y_.data() + offsets_[number];
+  double firstProduct = static_cast< double >(x[0] - x[count - 1]) * (x[1] - x[0]);
+  firstProduct += static_cast< double >(y[0] - y[count - 1]) * (y[1] - y[0]);
+  double lastProduct = static_cast< double >(x[count - 1] - x[count - 2]) * (x[0] - x[count - 1]);
+  lastProduct += static_cast< double >(y[count - 1] - y[count - 2]) * (y[0] - y[count - 1]);
+  bool found = firstProduct == 0 || lastProduct == 0;
+  for (size_t i = 1; i < count - 1; ++i)
+  {
+    double product = static_cast< double >(x[i] - x[i - 1]) * (x[i + 1] - x[i]);
+    product += static_cast< double >(y[i] - y[i - 1]) * (y[i + 1] - y[i]);
+    found |= product == 0;
+  }
+  return found;
+}
@@ -0,0 +1,23 @@
+#ifndef POLYGON_STORE_HPP
+#define POLYGON_STORE_HPP
+#include <vector>
+
+#include "geometry.hpp"
+
+namespace kostyukov
+{
+  class PolygonStore
+  {
+    public:
+      explicit PolygonStore(const std::vector< Polygon >& polygons);
+      size_t size() const;
+      size_t vertexes(size_t number) const;
+      double area(size_t number) const;
+      bool hasRightAngle(size_t number) const;
+    private:
+      std::vector< int > x_;
+      std::vector< int > y_;
+      std::vector< size_t > offsets_;
+  };
+}
+#endif
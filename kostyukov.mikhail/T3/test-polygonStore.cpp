@@ -0,0 +1,73 @@
+#define BOOST_TEST_MODULE kostyukov_t3_polygon_store
+#include <boost/test/included/unit_test.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "geometry.hpp"
+#include "polygonStore.hpp"
+
+namespace
+{
+  std::vector< kostyukov::Polygon > makePolygons(size_t count, unsigned seed)
+  {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution< int > coordinate(-50, 50);
+    std::uniform_int_distribution< size_t > vertexes(3, 8);
+    std::vector< kostyukov::Polygon > polygons(count);
+    for (auto it = polygons.begin(); it != polygons.end(); ++it)
+    {
+      it->points.resize(vertexes(generator));
+      for (auto point = it->points.begin(); point != it->points.end(); ++point)
+      {
+        point->x = coordinate(generator);
+        point->y = coordinate(generator);
+      }
+    }
+    return polygons;
+  }
+
+  struct RightAnglesInspector
+  {
+    const kostyukov::Polygon& polygon;
+    bool operator()(size_t number) const
+    {
+      size_t countVertexes = polygon.points.size();
+      const kostyukov::Point& previous = polygon.points[(number + countVertexes - 1) % countVertexes];
+      const kostyukov::Point& current = polygon.points[number];
+      const kostyukov::Point& next = polygon.points[(number + 1) % countVertexes];
+      double vector1_x = current.x - previous.x;
+      double vector1_y = current.y - previous.y;
+      double vector2_x = next.x - current.x;
+      double vector2_y = next.y - current.y;
+      return vector1_x * vector2_x + vector1_y * vector2_y == 0;
+    }
+  };
+
+  bool hasRightAnglesReference(const kostyukov::Polygon& polygon)
+  {
+    std::vector< size_t > numbers(polygon.points.size());
+    std::iota(numbers.begin(), numbers.end(), 0);
+    return std::any_of(numbers.begin(), numbers.end(), RightAnglesInspector{ polygon });
+  }
+}
+
+BOOST_AUTO_TEST_CASE(store_matches_polygons)
+{
+  std::vector< kostyukov::Polygon > polygons = makePolygons(2000, 29);
+  kostyukov::PolygonStore store(polygons);
+  BOOST_REQUIRE_EQUAL(store.size(), polygons.size());
+  double expectedSum = 0.0;
+  double storeSum = 0.0;
+  for (size_t i = 0; i < polygons.size(); ++i)
+  {
+    expectedSum += kostyukov::getArea(polygons[i]);
+    storeSum += store.area(i);
+    BOOST_REQUIRE_EQUAL(store.vertexes(i), polygons[i].points.size());
+    BOOST_CHECK_CLOSE(store.area(i), kostyukov::getArea(polygons[i]), 1e-9);
+    BOOST_REQUIRE_EQUAL(store.hasRightAngle(i), hasRightAnglesReference(polygons[i]));
+  }
+  BOOST_CHECK_CLOSE(storeSum, expectedSum, 1e-9);
+}
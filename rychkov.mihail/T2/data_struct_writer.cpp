@@ -0,0 +1,217 @@
+#include "data_struct_writer.hpp"
+
+#include <ostream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <limits>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace
+{
+  constexpr int min_power = -330;
+  constexpr int max_power = 330;
+  constexpr double boundary_margin = 1e-12;
+  constexpr double log10_2 = 0.30102999566398119521;
+
+  double ten_pow(int power)
+  {
+    static const std::vector< double > table = []()
+    {
+      std::vector< double > result;
+      for (int i = min_power; i <= max_power; i++)
+      {
+        result.push_back(std::pow(10., i));
+      }
+      return result;
+    }();
+    return table[power - min_power];
+  }
+
+  struct binary_parts
+  {
+    uint64_t mantissa;
+    int exponent;
+  };
+  // abs == mantissa * 2^exponent
+  binary_parts decompose(double abs)
+  {
+    constexpr int fraction_bits = std::numeric_limits< double >::digits - 1;
+    constexpr uint64_t fraction_mask = (uint64_t(1) << fraction_bits) - 1;
+    uint64_t bits = 0;
+    std::memcpy(&bits, &abs, sizeof(bits));
+    int biased = static_cast< int >(bits >> fraction_bits);
+    uint64_t mantissa = bits & fraction_mask;
+    if (biased == 0)
+    {
+      return {mantissa, 1 - 1023 - fraction_bits};
+    }
+    return {mantissa | (fraction_mask + 1), biased - 1023 - fraction_bits};
+  }
+
+  // floor(log10(abs)) without calling log10, unless abs is too close to a power of ten
+  // for the result to be independent of log10 rounding
+  bool decimal_power(double abs, int& power)
+  {
+    binary_parts parts = decompose(abs);
+    int exp2 = parts.exponent + std::numeric_limits< double >::digits - 1;
+    int guess = static_cast< int >(std::floor(exp2 * log10_2));
+    while ((guess + 1 < max_power) && (abs >= ten_pow(guess + 1)))
+    {
+      guess++;
+    }
+    if ((abs < ten_pow(guess) * (1 + boundary_margin)) || (abs > ten_pow(guess + 1) * (1 - boundary_margin)))
+    {
+      return false;
+    }
+    power = guess;
+    return true;
+  }
+
+  // the same digits as printf("%.1f"): the exact binary value rounded half to even
+  bool put_fixed(std::string& out, double value)
+  {
+    if (!std::isfinite(value) || (std::fabs(value) >= 1e15))
+    {
+      return false;
+    }
+    binary_parts parts = decompose(std::fabs(value));
+    uint64_t tenths = 0;
+    if (parts.mantissa != 0)
+    {
+      int shift = -parts.exponent;
+      if ((shift <= 0) || (shift >= 64))
+      {
+        return false;
+      }
+      uint64_t scaled = parts.mantissa * 10;
+      tenths = scaled >> shift;
+      uint64_t rest = scaled & ((uint64_t(1) << shift) - 1);
+      uint64_t half = uint64_t(1) << (shift - 1);
+      if ((rest > half) || ((rest == half) && (tenths & 1)))
+      {
+        tenths++;
+      }
+    }
+
+    if (std::signbit(value))
+    {
+      out += '-';
+    }
+    char digits[24];
+    char* end = digits + sizeof(digits);
+    char* begin = end;
+    *--begin = static_cast< char >('0' + tenths % 10);
+    *--begin = '.';
+    uint64_t whole = tenths / 10;
+    do
+    {
+      *--begin = static_cast< char >('0' + whole % 10);
+      whole /= 10;
+    }
+    while (whole != 0);
+    out.append(begin, end);
+    return true;
+  }
+}
+
+rychkov::ds_writer::ds_writer(std::ostream& out, size_t capacity):
+  out_(out),
+  capacity_(capacity)
+{
+  buffer_.reserve(capacity_);
+}
+rychkov::ds_writer::~ds_writer()
+{
+  flush();
+}
+rychkov::ds_writer& rychkov::ds_writer::write(const DataStruct& value)
+{
+  buffer_ += "(:key1 ";
+  put_scientific(value.key1);
+  buffer_ += ":key2 ";
+  put_integer(value.key2);
+  buffer_ += "ll:key3 \"";
+  buffer_ += value.key3;
+  buffer_ += "\":)";
+  if (buffer_.size() >= capacity_)
+  {
+    flush();
+  }
+  return *this;
+}
+rychkov::ds_writer& rychkov::ds_writer::write(const char* text)
+{
+  buffer_ += text;
+  if (buffer_.size() >= capacity_)
+  {
+    flush();
+  }
+  return *this;
+}
+void rychkov::ds_writer::flush()
+{
+  out_.write(buffer_.data(), buffer_.size());
+  buffer_.clear();
+}
+void rychkov::ds_writer::put_scientific(double value)
+{
+  int power = 0;
+  if (value != 0)
+  {
+    double abs = std::fabs(value);
+    if (!std::isnormal(abs))
+    {
+      put_fallback(value);
+      return;
+    }
+    if (!decimal_power(abs, power))
+    {
+      power = static_cast< int >(std::floor(std::log10(abs)));
+    }
+  }
+  if (!put_fixed(buffer_, value * ten_pow(-power)))
+  {
+    put_fallback(value);
+    return;
+  }
+  buffer_ += 'e';
+  buffer_ += power < 0 ? '-' : '+';
+  int digits = power < 0 ? -power : power;
+  if (digits >= 100)
+  {
+    buffer_ += static_cast< char >('0' + digits / 100);
+  }
+  if (digits >= 10)
+  {
+    buffer_ += static_cast< char >('0' + digits / 10 % 10);
+  }
+  buffer_ += static_cast< char >('0' + digits % 10);
+}
+void rychkov::ds_writer::put_integer(long long value)
+{
+  unsigned long long rest = static_cast< unsigned long long >(value);
+  if (value < 0)
+  {
+    buffer_ += '-';
+    rest = 0 - rest;
+  }
+  char digits[24];
+  char* end = digits + sizeof(digits);
+  char* begin = end;
+  do
+  {
+    *--begin = static_cast< char >('0' + rest % 10);
+    rest /= 10;
+  }
+  while (rest != 0);
+  buffer_.append(begin, end);
+}
+void rychkov::ds_writer::put_fallback(double value)
+{
+  std::ostringstream out;
+  out << std::setprecision(1) << iofmt::scientific_literal(value);
+  buffer_ += out.str();
+}
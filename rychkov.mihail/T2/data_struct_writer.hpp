@@ -0,0 +1,33 @@
+#ifndef DATA_STRUCT_WRITER_HPP
+#define DATA_STRUCT_WRITER_HPP
+
+#include <string>
+#include <iosfwd>
+#include "data_struct.hpp"
+
+namespace rychkov
+{
+  class ds_writer
+  {
+  public:
+    static constexpr size_t default_capacity = 1 << 20;
+
+    explicit ds_writer(std::ostream& out, size_t capacity = default_capacity);
+    ds_writer(const ds_writer&) = delete;
+    ~ds_writer();
+
+    ds_writer& write(const DataStruct& value);
+    ds_writer& write(const char* text);
+    void flush();
+  private:
+    std::ostream& out_;
+    size_t capacity_;
+    std::string buffer_;
+
+    void put_scientific(double value);
+    void put_integer(long long value);
+    void put_fallback(double value);
+  };
+}
+
+#endif
@@ -3,9 +3,9 @@
 #include <vector>
 #include <iterator>
 #include <limits>
-#include <iomanip>
 
 #include "data_struct.hpp"
+#include "data_struct_writer.hpp"
 
 namespace rychkov
 {
@@ -39,6 +39,9 @@ int main()
   }
   std::sort(values.begin(), values.end(), rychkov::ds_compare{});
 
-  std::cout << std::setprecision(1);
-  std::copy(values.begin(), values.end(), std::ostream_iterator< data_t >{std::cout, "\n"});
+  rychkov::ds_writer writer(std::cout);
+  for (const data_t& value: values)
+  {
+    writer.write(value).write("\n");
+  }
 }
@@ -1,4 +1,7 @@
 #include "file-system.hpp"
+#include <vector>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <algorithm>
 #include <unordered_map>
@@ -82,17 +85,265 @@ bool savintsev::validate_savi_file(const std::string & filename)
   return file.eof();
 }
 
+namespace
+{
+  constexpr char savi_magic[4] = {'S', 'A', 'V', 'I'};
+  constexpr uint32_t savi_version = 1;
+  constexpr size_t max_points = 4;
+  constexpr size_t block_size = 1 << 20;
+  constexpr uint64_t fnv_basis = 14695981039346656037ull;
+
+  uint64_t checksum(uint64_t hash, const char * data, size_t size)
+  {
+    for (size_t i = 0; i < size; ++i)
+    {
+      hash = (hash ^ static_cast< unsigned char >(data[i])) * 1099511628211ull;
+    }
+    return hash;
+  }
+
+  class BinaryWriter
+  {
+  public:
+    explicit BinaryWriter(std::ostream & out):
+      out_(out),
+      hash_(fnv_basis)
+    {
+      buffer_.reserve(block_size);
+    }
+    void put_bytes(const char * data, size_t size)
+    {
+      buffer_.append(data, size);
+      if (buffer_.size() >= block_size)
+      {
+        flush();
+      }
+    }
+    void put_u32(uint32_t value)
+    {
+      char bytes[4];
+      for (size_t i = 0; i < 4; ++i)
+      {
+        bytes[i] = static_cast< char >(value >> (8 * i));
+      }
+      put_bytes(bytes, 4);
+    }
+    void put_u64(uint64_t value)
+    {
+      put_u32(static_cast< uint32_t >(value));
+      put_u32(static_cast< uint32_t >(value >> 32));
+    }
+    void put_double(double value)
+    {
+      uint64_t bits = 0;
+      std::memcpy(&bits, &value, sizeof(bits));
+      put_u64(bits);
+    }
+    void put_string(const std::string & value)
+    {
+      put_u32(static_cast< uint32_t >(value.size()));
+      put_bytes(value.data(), value.size());
+    }
+    void finish()
+    {
+      flush();
+      uint64_t sum = hash_;
+      put_u64(sum);
+      out_.write(buffer_.data(), buffer_.size());
+      buffer_.clear();
+      out_.flush();
+    }
+  private:
+    std::ostream & out_;
+    std::string buffer_;
+    uint64_t hash_;
+
+    void flush()
+    {
+      hash_ = checksum(hash_, buffer_.data(), buffer_.size());
+      out_.write(buffer_.data(), buffer_.size());
+      buffer_.clear();
+    }
+  };
+
+  class BinaryReader
+  {
+  public:
+    BinaryReader(const char * begin, const char * end):
+      pos_(begin),
+      end_(end)
+    {}
+    bool get_u32(uint32_t & value)
+    {
+      if (end_ - pos_ < 4)
+      {
+        return false;
+      }
+      value = 0;
+      for (size_t i = 0; i < 4; ++i)
+      {
+        value |= static_cast< uint32_t >(static_cast< unsigned char >(*pos_++)) << (8 * i);
+      }
+      return true;
+    }
+    bool get_u64(uint64_t & value)
+    {
+      uint32_t low = 0;
+      uint32_t high = 0;
+      if (!get_u32(low) || !get_u32(high))
+      {
+        return false;
+      }
+      value = (static_cast< uint64_t >(high) << 32) | low;
+      return true;
+    }
+    bool get_double(double & value)
+    {
+      uint64_t bits = 0;
+      if (!get_u64(bits))
+      {
+        return false;
+      }
+      std::memcpy(&value, &bits, sizeof(value));
+      return true;
+    }
+    bool get_string(std::string & value)
+    {
+      uint32_t size = 0;
+      if (!get_u32(size) || static_cast< size_t >(end_ - pos_) < size)
+      {
+        return false;
+      }
+      value.assign(pos_, size);
+      pos_ += size;
+      return true;
+    }
+    bool at_end() const
+    {
+      return pos_ == end_;
+    }
+  private:
+    const char * pos_;
+    const char * end_;
+  };
+
+  std::string read_blocks(std::istream & in)
+  {
+    std::string data;
+    std::streambuf * buf = in.rdbuf();
+    std::streamsize got = 0;
+    do
+    {
+      size_t old = data.size();
+      data.resize(old + block_size);
+      got = buf->sgetn(&data[old], block_size);
+      data.resize(old + got);
+    }
+    while (got > 0);
+    return data;
+  }
+
+  bool read_binary_project(const std::string & data, savintsev::Project & project)
+  {
+    if (data.size() < 8)
+    {
+      return false;
+    }
+    const char * begin = data.data();
+    const char * body_end = begin + data.size() - 8;
+    uint64_t stored = 0;
+    BinaryReader(body_end, begin + data.size()).get_u64(stored);
+    uint64_t sum = checksum(checksum(fnv_basis, savi_magic, sizeof(savi_magic)), begin, body_end - begin);
+    if (stored != sum)
+    {
+      return false;
+    }
+
+    BinaryReader in(begin, body_end);
+    uint32_t version = 0;
+    uint32_t type_count = 0;
+    if (!in.get_u32(version) || version != savi_version || !in.get_u32(type_count))
+    {
+      return false;
+    }
+    std::vector< std::string > types;
+    for (uint32_t i = 0; i < type_count; ++i)
+    {
+      std::string type;
+      if (!in.get_string(type))
+      {
+        return false;
+      }
+      types.push_back(type);
+    }
+
+    uint64_t layer_count = 0;
+    if (!in.get_u64(layer_count))
+    {
+      return false;
+    }
+    for (uint64_t i = 0; i < layer_count; ++i)
+    {
+      uint32_t type = 0;
+      uint32_t point_count = 0;
+      std::string name;
+      if (!in.get_u32(type) || type >= types.size() || !in.get_string(name))
+      {
+        return false;
+      }
+      if (!in.get_u32(point_count) || point_count > max_points)
+      {
+        return false;
+      }
+      savintsev::point_t ps[max_points];
+      for (uint32_t j = 0; j < point_count; ++j)
+      {
+        if (!in.get_double(ps[j].x) || !in.get_double(ps[j].y))
+        {
+          return false;
+        }
+      }
+      savintsev::Shape * shape = savintsev::createShape(types[type], name, ps, point_count);
+      if (!shape)
+      {
+        return false;
+      }
+      project.push_back({types[type], savintsev::ShapeHandle(shape)});
+    }
+    return in.at_end();
+  }
+}
+
 void savintsev::read_savi_file(const std::string & filename, Projects & projs)
 {
-  std::ifstream file(filename);
+  std::ifstream file(filename, std::ios::binary);
 
-  if (!file || !validate_savi_file(filename))
+  if (!file || !has_savi_extension(filename))
   {
     throw std::runtime_error("Can't open " + get_filename_wext(filename));
   }
 
   Project project;
 
+  char magic[sizeof(savi_magic)] = {};
+  file.read(magic, sizeof(magic));
+  if (file.gcount() == sizeof(magic) && std::equal(magic, magic + sizeof(magic), savi_magic))
+  {
+    if (!read_binary_project(read_blocks(file), project))
+    {
+      throw std::runtime_error("Can't open " + get_filename_wext(filename));
+    }
+    projs[get_filename(filename)] = std::move(project);
+    return;
+  }
+
+  file.clear();
+  file.seekg(0);
+  if (!validate_savi_file(filename))
+  {
+    throw std::runtime_error("Can't open " + get_filename_wext(filename));
+  }
+
   std::string figure;
   file >> figure;
 
@@ -104,45 +355,63 @@ void savintsev::read_savi_file(const std::string & filename, Projects & projs)
     {
       throw std::runtime_error("Can't open " + get_filename_wext(filename));
     }
-    new_pair = {figure, new_shape};
+    new_pair = {figure, ShapeHandle(new_shape)};
     project.push_back(new_pair);
 
     file >> figure;
   }
 
-  projs[get_filename(filename)] = project;
+  projs[get_filename(filename)] = std::move(project);
 }
 
 void savintsev::write_savi_file(const std::string & filename, Project & proj)
 {
-  std::ofstream file(filename + ".savi");
+  std::ofstream file(filename + ".savi", std::ios::binary);
 
   if (!file)
   {
     throw std::runtime_error("Failed to save project to " + filename + ".savi");
   }
 
+  std::vector< std::string > types;
+  std::unordered_map< std::string, uint32_t > type_ids;
   for (auto it = proj.begin(); it != proj.end(); ++it)
   {
-    file << it->first << " " << it->second->get_name();
-    point_t ps[4];
-    for (size_t i = 0; i < it->second->get_all_points(ps); ++i)
+    if (type_ids.emplace(it->first, static_cast< uint32_t >(types.size())).second)
     {
-      file << " " << ps[i].x << " " << ps[i].y;
+      types.push_back(it->first);
     }
-    file << '\n';
   }
-}
 
-namespace
-{
-  struct Deleter
+  BinaryWriter writer(file);
+  writer.put_bytes(savi_magic, sizeof(savi_magic));
+  writer.put_u32(savi_version);
+  writer.put_u32(static_cast< uint32_t >(types.size()));
+  for (auto it = types.begin(); it != types.end(); ++it)
+  {
+    writer.put_string(*it);
+  }
+
+  writer.put_u64(proj.size());
+  for (auto it = proj.begin(); it != proj.end(); ++it)
   {
-    void operator()(savintsev::Layer & layer) const
+    point_t ps[max_points];
+    size_t point_count = it->second->get_all_points(ps);
+    writer.put_u32(type_ids[it->first]);
+    writer.put_string(it->second->get_name());
+    writer.put_u32(static_cast< uint32_t >(point_count));
+    for (size_t i = 0; i < point_count; ++i)
     {
-      delete layer.second;
+      writer.put_double(ps[i].x);
+      writer.put_double(ps[i].y);
     }
-  };
+  }
+  writer.finish();
+
+  if (!file)
+  {
+    throw std::runtime_error("Failed to save project to " + filename + ".savi");
+  }
 }
 
 void savintsev::cleanup_projects_with_backup(Projects & projects)
@@ -153,7 +422,6 @@ void savintsev::cleanup_projects_with_backup(Projects & projects)
     {
       Project & proj = proj_pair.second;
       write_savi_file(proj_pair.first + "_backup", proj);
-      std::for_each(proj.begin(), proj.end(), Deleter());
       proj.clear();
     }
   };
@@ -168,7 +436,6 @@ void savintsev::cleanup_projects_without_backup(Projects& projects)
     void operator()(std::pair< const std::string, Project > & proj_pair) const
     {
       Project & proj = proj_pair.second;
-      std::for_each(proj.begin(), proj.end(), Deleter());
       proj.clear();
     }
   };
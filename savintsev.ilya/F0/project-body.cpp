@@ -0,0 +1,197 @@
+#include "project-body.hpp"
+#include <algorithm>
+
+savintsev::ShapeHandle::ShapeHandle(Shape * shape):
+  shape_(shape)
+{}
+
+const savintsev::Shape * savintsev::ShapeHandle::get() const noexcept
+{
+  return shape_.get();
+}
+
+const savintsev::Shape * savintsev::ShapeHandle::operator->() const noexcept
+{
+  return shape_.get();
+}
+
+const savintsev::Shape & savintsev::ShapeHandle::operator*() const noexcept
+{
+  return *shape_;
+}
+
+savintsev::Shape & savintsev::ShapeHandle::edit()
+{
+  if (shape_.use_count() > 1)
+  {
+    shape_.reset(shape_->clone());
+  }
+  return *shape_;
+}
+
+savintsev::Project::Project(const Project & other):
+  layers_(other.layers_)
+{
+  for (auto it = layers_.begin(); it != layers_.end(); ++it)
+  {
+    index_.emplace(it->second->get_name(), it);
+  }
+}
+
+savintsev::Project & savintsev::Project::operator=(const Project & other)
+{
+  Project copy(other);
+  *this = std::move(copy);
+  return *this;
+}
+
+savintsev::Project::iterator savintsev::Project::begin() noexcept
+{
+  return layers_.begin();
+}
+
+savintsev::Project::iterator savintsev::Project::end() noexcept
+{
+  return layers_.end();
+}
+
+savintsev::Project::const_iterator savintsev::Project::begin() const noexcept
+{
+  return layers_.begin();
+}
+
+savintsev::Project::const_iterator savintsev::Project::end() const noexcept
+{
+  return layers_.end();
+}
+
+savintsev::Project::const_reverse_iterator savintsev::Project::rbegin() const noexcept
+{
+  return layers_.rbegin();
+}
+
+savintsev::Project::const_reverse_iterator savintsev::Project::rend() const noexcept
+{
+  return layers_.rend();
+}
+
+size_t savintsev::Project::size() const noexcept
+{
+  return layers_.size();
+}
+
+bool savintsev::Project::empty() const noexcept
+{
+  return layers_.empty();
+}
+
+namespace
+{
+  struct ShapeNameEquals
+  {
+    const std::string & name;
+    bool operator()(const savintsev::Layer & layer) const
+    {
+      return layer.second->get_name() == name;
+    }
+  };
+}
+
+savintsev::Project::iterator savintsev::Project::find(const std::string & name)
+{
+  auto range = index_.equal_range(name);
+  if (range.first == range.second)
+  {
+    return layers_.end();
+  }
+  if (std::next(range.first) == range.second)
+  {
+    return range.first->second;
+  }
+  return std::find_if(layers_.begin(), layers_.end(), ShapeNameEquals{name});
+}
+
+savintsev::Project::iterator savintsev::Project::insert(const_iterator pos, const Layer & layer)
+{
+  iterator it = layers_.insert(pos, layer);
+  try
+  {
+    index_.emplace(it->second->get_name(), it);
+  }
+  catch (...)
+  {
+    layers_.erase(it);
+    throw;
+  }
+  return it;
+}
+
+void savintsev::Project::push_back(const Layer & layer)
+{
+  insert(layers_.end(), layer);
+}
+
+savintsev::Project::iterator savintsev::Project::erase(const_iterator pos)
+{
+  unindex(pos);
+  return layers_.erase(pos);
+}
+
+void savintsev::Project::splice(const_iterator pos, const_iterator layer)
+{
+  layers_.splice(pos, layers_, layer);
+}
+
+void savintsev::Project::swap_layers(const_iterator lhs, const_iterator rhs)
+{
+  if (lhs == rhs)
+  {
+    return;
+  }
+  if (std::next(lhs) == rhs)
+  {
+    layers_.splice(lhs, layers_, rhs);
+  }
+  else if (std::next(rhs) == lhs)
+  {
+    layers_.splice(rhs, layers_, lhs);
+  }
+  else
+  {
+    const_iterator after_rhs = std::next(rhs);
+    layers_.splice(lhs, layers_, rhs);
+    layers_.splice(after_rhs, layers_, lhs);
+  }
+}
+
+void savintsev::Project::rename(iterator pos, const std::string & name)
+{
+  Shape & shape = pos->second.edit();
+  unindex(pos);
+  shape.set_name(name);
+  index_.emplace(name, pos);
+}
+
+void savintsev::Project::reverse() noexcept
+{
+  layers_.reverse();
+}
+
+void savintsev::Project::clear() noexcept
+{
+  index_.clear();
+  layers_.clear();
+}
+
+void savintsev::Project::unindex(const_iterator pos)
+{
+  auto range = index_.equal_range(pos->second->get_name());
+  for (auto it = range.first; it != range.second; ++it)
+  {
+    if (it->second == pos)
+    {
+      index_.erase(it);
+      return;
+    }
+  }
+}
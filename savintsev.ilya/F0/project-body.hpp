@@ -2,13 +2,72 @@
 #define PROJECT_BODY_HPP
 #include <map>
 #include <list>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <shape.hpp>
 
 namespace savintsev
 {
-  using Layer = std::pair< std::string, Shape * >;
-  using Project = std::list< Layer >;
+  class ShapeHandle
+  {
+  public:
+    ShapeHandle() = default;
+    explicit ShapeHandle(Shape * shape);
+
+    const Shape * get() const noexcept;
+    const Shape * operator->() const noexcept;
+    const Shape & operator*() const noexcept;
+
+    Shape & edit();
+  private:
+    std::shared_ptr< Shape > shape_;
+  };
+
+  using Layer = std::pair< std::string, ShapeHandle >;
+
+  class Project
+  {
+  public:
+    using value_type = Layer;
+    using iterator = std::list< Layer >::iterator;
+    using const_iterator = std::list< Layer >::const_iterator;
+    using const_reverse_iterator = std::list< Layer >::const_reverse_iterator;
+
+    Project() = default;
+    Project(const Project & other);
+    Project(Project && other) = default;
+    Project & operator=(const Project & other);
+    Project & operator=(Project && other) = default;
+
+    iterator begin() noexcept;
+    iterator end() noexcept;
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+    const_reverse_iterator rbegin() const noexcept;
+    const_reverse_iterator rend() const noexcept;
+
+    size_t size() const noexcept;
+    bool empty() const noexcept;
+
+    iterator find(const std::string & name);
+
+    iterator insert(const_iterator pos, const Layer & layer);
+    void push_back(const Layer & layer);
+    iterator erase(const_iterator pos);
+
+    void splice(const_iterator pos, const_iterator layer);
+    void swap_layers(const_iterator lhs, const_iterator rhs);
+    void rename(iterator pos, const std::string & name);
+    void reverse() noexcept;
+    void clear() noexcept;
+  private:
+    std::list< Layer > layers_;
+    std::unordered_multimap< std::string, iterator > index_;
+
+    void unindex(const_iterator pos);
+  };
+
   using Projects = std::map< std::string, Project >;
 }
 
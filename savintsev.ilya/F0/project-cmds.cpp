@@ -2,6 +2,7 @@
 #include <fstream>
 #include <algorithm>
 #include <functional>
+#include <unordered_map>
 #include <shape-utils.hpp>
 #include "renderer.hpp"
 #include "file-system.hpp"
@@ -63,17 +64,6 @@ namespace
       savintsev::write_savi_file(entry.first, entry.second);
     }
   };
-  struct ShapeNameEquals
-  {
-    const std::string & name;
-    ShapeNameEquals(const std::string & n):
-      name(n)
-    {}
-    bool operator()(const savintsev::Layer & layer) const
-    {
-      return layer.second && layer.second->get_name() == name;
-    }
-  };
   std::string make_sh(std::istream & in, savintsev::Projects & projs, std::string shape_name)
   {
     std::string proj;
@@ -84,18 +74,9 @@ namespace
     {
       throw std::runtime_error("Incorrect description of the shape");
     }
-    projs[proj].push_back({shape_name, shape});
+    projs[proj].push_back({shape_name, savintsev::ShapeHandle(shape)});
     return proj;
   }
-  struct CloneLayer
-  {
-    CloneLayer() = default;
-
-    savintsev::Layer operator()(const savintsev::Layer & layer) const
-    {
-      return {layer.first, layer.second->clone()};
-    }
-  };
   struct MoveLayer
   {
     MoveLayer(double dx, double dy):
@@ -104,19 +85,12 @@ namespace
     {}
     void operator()(savintsev::Layer & layer) const
     {
-      layer.second->move(dx_, dy_);
+      layer.second.edit().move(dx_, dy_);
     }
   private:
     double dx_;
     double dy_;
   };
-  struct Deleter
-  {
-    void operator()(savintsev::Layer & layer) const
-    {
-      delete layer.second;
-    }
-  };
 }
 
 void savintsev::save_all(std::ostream & out, Projects & projs)
@@ -134,8 +108,8 @@ void savintsev::merge(std::istream & in, std::ostream & out, Projects & projs)
   const Project & first = projs.at(src1);
   const Project & second = projs.at(src2);
 
-  std::transform(first.begin(), first.end(), std::back_inserter(target), CloneLayer());
-  std::transform(second.begin(), second.end(), std::back_inserter(target), CloneLayer());
+  std::copy_n(first.begin(), first.size(), std::back_inserter(target));
+  std::copy_n(second.begin(), second.size(), std::back_inserter(target));
 
   out << "Project \"" << src1 << "\" has been successfully merged with project \"" << src2 << "\"\n";
 }
@@ -163,10 +137,9 @@ void savintsev::delete_shape(std::istream & in, std::ostream & out, Projects & p
   std::string proj, shape_name;
   in >> proj >> shape_name;
   Project & pr = projs.at(proj);
-  auto it = std::find_if(pr.begin(), pr.end(), ShapeNameEquals(shape_name));
+  auto it = pr.find(shape_name);
   if (it != pr.end())
   {
-    delete it->second;
     pr.erase(it);
     out << "\"" << shape_name << "\" was successfully removed from \"" << proj << "\"\n";
     return;
@@ -183,21 +156,19 @@ void savintsev::copy_proj_or_shape(std::istream & in, std::ostream & out, Projec
   {
     Project & source = projs.at(proj);
     Project & target = projs[second];
-    std::transform(source.begin(), source.end(), std::back_inserter(target), CloneLayer());
+    std::copy_n(source.begin(), source.size(), std::back_inserter(target));
     out << "Project \"" << proj << "\" was successfully copied to \"" << second << "\"\n";
   }
   else
   {
     Project & pr = projs.at(proj);
-    auto it = std::find_if(pr.begin(), pr.end(), ShapeNameEquals(second));
+    auto it = pr.find(second);
     if (it == pr.end())
     {
       out << "\"" << second << "\" not found in project \"" << proj << "\"\n";
       return;
     }
-    Shape * cloned = it->second->clone();
-    cloned->set_name(third);
-    pr.insert(std::next(it), std::make_pair(it->first, cloned));
+    pr.rename(pr.insert(std::next(it), *it), third);
     out << "\"" << second << "\" was copied as \"" << third << "\" in project \"" << proj << "\"\n";
   }
 }
@@ -210,16 +181,14 @@ void savintsev::insert_shape(std::istream & in, std::ostream & out, Projects & p
   Project & from = projs.at(src_proj);
   Project & to = projs.at(dest_proj);
 
-  auto it = std::find_if(from.begin(), from.end(), ShapeNameEquals(shape_name));
+  auto it = from.find(shape_name);
   if (it == from.end())
   {
     out << "\"" << shape_name << "\" not found in project \"" << src_proj << "\"\n";
     return;
   }
 
-  Shape * cloned = it->second->clone();
-  to.push_back(std::make_pair(it->first, cloned));
-  cloned->set_name(shape_name + "_copy");
+  to.rename(to.insert(to.end(), *it), shape_name + "_copy");
 
   out << "\"" << shape_name << "\" from \"" << src_proj << "\" was inserted into \"" << dest_proj << "\"\n";
 }
@@ -232,7 +201,7 @@ void savintsev::rename_proj_or_shape(std::istream & in, std::ostream & out, Proj
   if (in.peek() == '\n' || !(in >> third))
   {
     const std::string & new_name = second;
-    projs[new_name] = projs.at(proj);
+    projs[new_name] = std::move(projs.at(proj));
     projs.erase(proj);
     out << "Project \"" << proj << "\" was successfully renamed to \"" << new_name << "\"\n";
   }
@@ -242,7 +211,7 @@ void savintsev::rename_proj_or_shape(std::istream & in, std::ostream & out, Proj
     const std::string & new_name = third;
 
     Project & pr = projs.at(proj);
-    auto it = std::find_if(pr.begin(), pr.end(), ShapeNameEquals(old_name));
+    auto it = pr.find(old_name);
 
     if (it == pr.end())
     {
@@ -250,7 +219,7 @@ void savintsev::rename_proj_or_shape(std::istream & in, std::ostream & out, Proj
       return;
     }
 
-    it->second->set_name(new_name);
+    pr.rename(it, new_name);
     out << "\"" << old_name << "\" was renamed to \"" << new_name << "\" in project \"" << proj << "\"\n";
   }
 }
@@ -262,7 +231,7 @@ void savintsev::sf(std::istream & in, std::ostream & out, Projects & projs)
   in >> proj >> name >> n;
 
   Project & pr = projs.at(proj);
-  auto it = std::find_if(pr.begin(), pr.end(), ShapeNameEquals(name));
+  auto it = pr.find(name);
 
   if (it == pr.end())
   {
@@ -301,14 +270,14 @@ void savintsev::sf_above(std::istream & in, std::ostream & out, Projects & projs
   in >> proj >> name;
 
   Project & pr = projs.at(proj);
-  auto it = std::find_if(pr.begin(), pr.end(), ShapeNameEquals(name));
+  auto it = pr.find(name);
   if (it == pr.end())
   {
     out << "\"" << name << "\" not found in project \"" << proj << "\"\n";
     return;
   }
 
-  pr.splice(pr.end(), pr, it);
+  pr.splice(pr.end(), it);
   out << "\"" << name << "\" was moved to the top in project \"" << proj << "\"\n";
 }
 
@@ -318,14 +287,14 @@ void savintsev::sf_below(std::istream & in, std::ostream & out, Projects & projs
   in >> proj >> name;
 
   Project & pr = projs.at(proj);
-  auto it = std::find_if(pr.begin(), pr.end(), ShapeNameEquals(name));
+  auto it = pr.find(name);
   if (it == pr.end())
   {
     out << "\"" << name << "\" not found in project \"" << proj << "\"\n";
     return;
   }
 
-  pr.splice(pr.begin(), pr, it);
+  pr.splice(pr.begin(), it);
   out << "\"" << name << "\" was moved to the bottom in project \"" << proj << "\"\n";
 }
 
@@ -336,8 +305,8 @@ void savintsev::swap_shapes(std::istream & in, std::ostream & out, Projects & pr
 
   Project & pr = projs.at(proj);
 
-  auto it1 = std::find_if(pr.begin(), pr.end(), ShapeNameEquals(name1));
-  auto it2 = std::find_if(pr.begin(), pr.end(), ShapeNameEquals(name2));
+  auto it1 = pr.find(name1);
+  auto it2 = pr.find(name2);
 
   if (it1 == pr.end() || it2 == pr.end())
   {
@@ -351,7 +320,7 @@ void savintsev::swap_shapes(std::istream & in, std::ostream & out, Projects & pr
     return;
   }
 
-  std::iter_swap(it1, it2);
+  pr.swap_layers(it1, it2);
   out << "\"" << name1 << "\" and \"" << name2 << "\" were swapped in \"" << proj << "\"\n";
 }
 
@@ -361,13 +330,13 @@ void savintsev::move_abs(std::istream & in, std::ostream & out, Projects & projs
   double x, y;
   in >> proj >> name >> x >> y;
   auto & pr = projs.at(proj);
-  auto it = std::find_if(pr.begin(), pr.end(), ShapeNameEquals(name));
+  auto it = pr.find(name);
   if (it == pr.end())
   {
     out << "\"" << name << "\" not found in project \"" << proj << "\"\n";
     return;
   }
-  it->second->move({x, y});
+  it->second.edit().move({x, y});
   out << "\"" << name << "\" was succesfully moved\n";
 }
 
@@ -377,13 +346,13 @@ void savintsev::move_rel(std::istream & in, std::ostream & out, Projects & projs
   double dx, dy;
   in >> proj >> name >> dx >> dy;
   auto & pr = projs.at(proj);
-  auto it = std::find_if(pr.begin(), pr.end(), ShapeNameEquals(name));
+  auto it = pr.find(name);
   if (it == pr.end())
   {
     out << "\"" << name << "\" not found in project \"" << proj << "\"\n";
     return;
   }
-  it->second->move(dx, dy);
+  it->second.edit().move(dx, dy);
   out << "\"" << name << "\" was succesfully moved\n";
 }
 
@@ -403,13 +372,13 @@ void savintsev::scale_shape(std::istream & in, std::ostream & out, Projects & pr
   double k;
   in >> proj >> name >> k;
   auto & pr = projs.at(proj);
-  auto it = std::find_if(pr.begin(), pr.end(), ShapeNameEquals(name));
+  auto it = pr.find(name);
   if (it == pr.end())
   {
     out << "\"" << name << "\" not found in project \"" << proj << "\"\n";
     return;
   }
-  it->second->scale(k);
+  it->second.edit().scale(k);
   out << "\"" << name << "\" was succesfully scaled\n";
 }
 
@@ -422,7 +391,7 @@ void savintsev::array_shapes(std::istream & in, std::ostream & out, Projects & p
   in >> proj >> name >> n >> dx >> dy;
 
   auto & pr = projs.at(proj);
-  auto it = std::find_if(pr.begin(), pr.end(), ShapeNameEquals(name));
+  auto it = pr.find(name);
   if (it == pr.end())
   {
     out << "\"" << name << "\" not found in project \"" << proj << "\"\n";
@@ -431,14 +400,15 @@ void savintsev::array_shapes(std::istream & in, std::ostream & out, Projects & p
 
   auto pos = std::next(it);
   const std::string type = it->first;
-  const Shape* base = it->second;
+  const Shape * base = it->second.get();
 
   for (int i = 1; i <= n; ++i)
   {
-    Shape* clone = base->clone();
-    clone->set_name(name + "_" + std::to_string(i));
-    clone->move(dx * i, dy * i);
-    pos = pr.insert(pos, {type, clone});
+    ShapeHandle copy(base->clone());
+    Shape & clone = copy.edit();
+    clone.set_name(name + "_" + std::to_string(i));
+    clone.move(dx * i, dy * i);
+    pos = pr.insert(pos, {type, copy});
     ++pos;
   }
 
@@ -463,7 +433,6 @@ void savintsev::clear_project(std::istream & in, std::ostream & out, Projects &
   ConfirmationPrompt prompt(in, out);
   if (prompt.ask("Are you sure you want to clear the project?"))
   {
-    std::for_each(pr.begin(), pr.end(), Deleter());
     pr.clear();
     out << "Project \"" << proj << "\" was successfully cleared\n";
     return;
@@ -548,10 +517,8 @@ void savintsev::print_shapes(std::istream & in, std::ostream & out, Projects & p
   shape_type["complexquad"] = "Cxquad";
   shape_type["concave"] = "Concav";
 
-  Project & pr = projs.at(proj);
-  pr.reverse();
-  std::for_each(pr.begin(), pr.end(), PrintShapeIndexed(out, shape_type));
-  pr.reverse();
+  const Project & pr = projs.at(proj);
+  std::for_each(pr.rbegin(), pr.rend(), PrintShapeIndexed(out, shape_type));
 }
 
 void savintsev::print_info_about_shape(std::istream & in, std::ostream & out, Projects  & projs)
@@ -560,7 +527,7 @@ void savintsev::print_info_about_shape(std::istream & in, std::ostream & out, Pr
   in >> proj >> name;
 
   Project & pr = projs.at(proj);
-  auto it = std::find_if(pr.begin(), pr.end(), ShapeNameEquals(name));
+  auto it = pr.find(name);
   if (it == pr.end())
   {
     out << "Figure \"" << name << "\" not found in project \"" << proj << "\"\n";
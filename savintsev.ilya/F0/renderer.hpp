@@ -1,8 +1,13 @@
 #ifndef RENDERER_HPP
 #define RENDERER_HPP
+#include <cmath>
+#include <atomic>
 #include <random>
+#include <thread>
+#include <vector>
 #include <algorithm>
 #include <functional>
+#include <unordered_map>
 #include <boost/gil.hpp>
 #include <boost/gil/extension/io/bmp.hpp>
 #include <shape-utils.hpp>
@@ -21,29 +26,68 @@ namespace savintsev
       auto view = gil::view(image);
 
       gil::fill_pixels(view, gil::rgb8_pixel_t(255, 255, 255));
-      struct RenderWrapper
+
+      std::vector< Polygon > polygons;
+      polygons.reserve(proj.size());
+      for (auto it = proj.begin(); it != proj.end(); ++it)
       {
-        RenderWrapper(Renderer * r, gil::rgb8_view_t & v):
-          renderer(r),
-          view(v)
-        {}
-        void operator()(const savintsev::Layer & layer)
+        Polygon poly;
+        if (prepare_shape(poly, it->second.get(), h))
         {
-          renderer->render_shape(view, layer.second);
+          polygons.push_back(poly);
         }
-        Renderer * renderer;
-        gil::rgb8_view_t & view;
-      };
+      }
 
-      std::for_each(proj.begin(), proj.end(), RenderWrapper(this, view));
+      render_tiles(view, polygons);
 
       gil::write_view(name + ".bmp", view, gil::bmp_tag{});
     }
   private:
-    private:
-    void render_shape(gil::rgb8_view_t & view, const savintsev::Shape * shape)
+    static constexpr int tile_rows = 64;
+
+    struct Polygon
+    {
+      savintsev::point_t points[4];
+      size_t count;
+      int first_row;
+      int last_row;
+      gil::rgb8_pixel_t color;
+    };
+
+    struct TileWorker
+    {
+      Renderer * renderer;
+      gil::rgb8_view_t & view;
+      const std::vector< Polygon > & polygons;
+      std::atomic< int > & next;
+      int tiles;
+      int height;
+
+      void operator()()
+      {
+        for (int tile = next++; tile < tiles; tile = next++)
+        {
+          renderer->render_tile(view, polygons, tile * tile_rows, std::min(height, (tile + 1) * tile_rows));
+        }
+      }
+    };
+
+    std::unordered_map< std::string, gil::rgb8_pixel_t > colors_;
+
+    gil::rgb8_pixel_t get_color(const std::string & name)
     {
-      std::mt19937 rng(std::random_device{}());
+      auto it = colors_.find(name);
+      if (it != colors_.end())
+      {
+        return it->second;
+      }
+
+      uint32_t seed = 2166136261u;
+      for (size_t i = 0; i < name.size(); ++i)
+      {
+        seed = (seed ^ static_cast< unsigned char >(name[i])) * 16777619u;
+      }
+      std::mt19937 rng(seed);
       std::uniform_int_distribution<int> dist(50, 240);
 
       gil::rgb8_pixel_t color
@@ -52,64 +96,131 @@ namespace savintsev
         static_cast< uint8_t >(dist(rng)),
         static_cast< uint8_t >(dist(rng))
       );
+      colors_.emplace(name, color);
+      return color;
+    }
 
+    bool prepare_shape(Polygon & poly, const savintsev::Shape * shape, int height)
+    {
       savintsev::point_t points[4];
       size_t point_count = shape->get_all_points(points);
 
       if (point_count == 2)
       {
-        savintsev::point_t rect_points[4];
-        rect_points[0] = {points[0].x, points[0].y};
-        rect_points[1] = {points[1].x, points[0].y};
-        rect_points[2] = {points[1].x, points[1].y};
-        rect_points[3] = {points[0].x, points[1].y};
-        fill_shape(view, rect_points, 4, color);
+        poly.points[0] = {points[0].x, points[0].y};
+        poly.points[1] = {points[1].x, points[0].y};
+        poly.points[2] = {points[1].x, points[1].y};
+        poly.points[3] = {points[0].x, points[1].y};
+        poly.count = 4;
       }
       else
       {
-        fill_shape(view, points, point_count, color);
+        std::copy(points, points + point_count, poly.points);
+        poly.count = point_count;
       }
+      if (poly.count < 3)
+      {
+        return false;
+      }
+
+      savintsev::rectangle_t frame = shape->get_frame_rect();
+      double top = frame.pos.y + std::fabs(frame.height) / 2.0;
+      double bottom = frame.pos.y - std::fabs(frame.height) / 2.0;
+      double first = std::floor(height / 2.0 + 0.5 - top) - 1.0;
+      double last = std::ceil(height / 2.0 + 0.5 - bottom) + 1.0;
+      if (!(first < height) || !(last >= 0.0))
+      {
+        return false;
+      }
+      poly.first_row = first < 0.0 ? 0 : static_cast< int >(first);
+      poly.last_row = last >= height ? height - 1 : static_cast< int >(last);
+      poly.color = get_color(shape->get_name());
+      return true;
     }
-    void fill_shape(gil::rgb8_view_t & view, const savintsev::point_t * points, size_t count, gil::rgb8_pixel_t c)
+
+    void render_tiles(gil::rgb8_view_t & view, const std::vector< Polygon > & polygons)
     {
-      if (count < 3)
+      int height = view.height();
+      int tiles = (height + tile_rows - 1) / tile_rows;
+      size_t workers = std::min< size_t >(std::max(1u, std::thread::hardware_concurrency()), tiles);
+      std::atomic< int > next(0);
+      TileWorker worker{this, view, polygons, next, tiles, height};
+
+      std::vector< std::thread > threads;
+      for (size_t i = 1; i < workers; ++i)
       {
-        return;
+        threads.emplace_back(worker);
+      }
+      worker();
+      std::for_each(threads.begin(), threads.end(), std::mem_fn(&std::thread::join));
+    }
+
+    void render_tile(gil::rgb8_view_t & view, const std::vector< Polygon > & polygons, int from, int to)
+    {
+      for (auto it = polygons.begin(); it != polygons.end(); ++it)
+      {
+        int first = std::max(from, it->first_row);
+        int last = std::min(to - 1, it->last_row);
+        for (int y = first; y <= last; ++y)
+        {
+          fill_row(view, *it, y);
+        }
       }
+    }
 
+    void fill_row(gil::rgb8_view_t & view, const Polygon & poly, int y)
+    {
       int width = view.width();
       int height = view.height();
+      double fy = height / 2.0 - y + 0.5;
 
-      for (int y = 0; y < height; ++y)
+      double crossings[4];
+      size_t count = 0;
+      for (size_t i = 0, j = poly.count - 1; i < poly.count; j = i++)
       {
-        for (int x = 0; x < width; ++x)
-        {
-          double fx = x - width / 2.0;
-          double fy = height / 2.0 - y;
+        double xi = poly.points[i].x, yi = poly.points[i].y;
+        double xj = poly.points[j].x, yj = poly.points[j].y;
 
-          if (is_point_in_polygon(points, count, fx + 0.5, fy + 0.5))
-          {
-            view(x, y) = c;
-          }
+        if ((yi > fy) != (yj > fy))
+        {
+          crossings[count++] = (xj - xi) * (fy - yi) / (yj - yi + 1e-15) + xi;
+        }
+      }
+      if (count == 0)
+      {
+        return;
+      }
+      for (size_t i = 1; i < count; ++i)
+      {
+        for (size_t j = i; j > 0 && crossings[j] < crossings[j - 1]; --j)
+        {
+          std::swap(crossings[j], crossings[j - 1]);
         }
       }
-    }
 
-    bool is_point_in_polygon(const savintsev::point_t * points, size_t point_count, double x, double y)
-    {
-      bool inside = false;
-      for (size_t i = 0, j = point_count - 1; i < point_count; j = i++)
+      double left = std::floor(crossings[0] + width / 2.0 - 0.5) - 1.0;
+      double right = std::ceil(crossings[count - 1] + width / 2.0 - 0.5) + 1.0;
+      if (!(left < width) || !(right >= 0.0))
       {
-        double xi = points[i].x, yi = points[i].y;
-        double xj = points[j].x, yj = points[j].y;
+        return;
+      }
+      int x = left < 0.0 ? 0 : static_cast< int >(left);
+      int x_last = right >= width ? width - 1 : static_cast< int >(right);
 
-        bool intersect = ((yi > y) != (yj > y)) && (x < (xj - xi) * (y - yi) / (yj - yi + 1e-15) + xi);
-        if (intersect)
+      auto pixel = view.row_begin(y) + x;
+      size_t passed = 0;
+      for (; x <= x_last; ++x, ++pixel)
+      {
+        double fx = x - width / 2.0 + 0.5;
+        while (passed < count && !(fx < crossings[passed]))
+        {
+          ++passed;
+        }
+        if ((count - passed) % 2)
         {
-          inside = !inside;
+          *pixel = poly.color;
         }
       }
-      return inside;
     }
   };
 }
@@ -41,3 +41,20 @@ savintsev::Shape * savintsev::createShape(std::istream & in, std::string name)
   }
   return nullptr;
 }
+
+savintsev::Shape * savintsev::createShape(const std::string & name, std::string title, const point_t * ps, size_t count)
+{
+  if (name == "rectangle" && count == 2)
+  {
+    return new Rectangle(ps[0], ps[1], std::move(title));
+  }
+  if (name == "complexquad" && count == 4)
+  {
+    return new Complexquad(ps[0], ps[1], ps[2], ps[3], std::move(title));
+  }
+  if (name == "concave" && count == 4)
+  {
+    return new Concave(ps[0], ps[1], ps[2], ps[3], std::move(title));
+  }
+  return nullptr;
+}
@@ -7,6 +7,7 @@
 namespace savintsev
 {
   savintsev::Shape * createShape(std::istream & in, std::string name);
+  savintsev::Shape * createShape(const std::string & name, std::string title, const point_t * ps, size_t count);
 }
 
 #endif
@@ -3,6 +3,7 @@
 #include <iterator>
 #include <algorithm>
 #include "processing_structures.hpp"
+#include "radix_sort.hpp"
 
 int main()
 {
@@ -18,6 +19,6 @@ int main()
 
     std::copy(data_in_s_it(std::cin), data_in_s_it(), std::back_inserter(array));
   }
-  std::sort(array.begin(), array.end());
+  zakirov::sort_data(array);
   std::copy(array.begin(), array.end(), data_out_s_it(std::cout, "\n"));
 }
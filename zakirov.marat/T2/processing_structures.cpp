@@ -3,7 +3,7 @@
 #include <stack>
 #include <stream_guardian.hpp>
 
-bool zakirov::Data::operator<(const Data & other)
+bool zakirov::Data::operator<(const Data & other) const
 {
   if (key1 != other.key1)
   {
@@ -14,7 +14,7 @@ bool zakirov::Data::operator<(const Data & other)
     return key2 < other.key2;
   }
 
-  return key3.size() < key3.size();
+  return key3.size() < other.key3.size();
 }
 
 std::istream & zakirov::operator>>(std::istream & in, Data & data)
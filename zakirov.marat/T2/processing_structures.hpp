@@ -6,7 +6,7 @@ namespace zakirov
 {
   struct Data
   {
-    bool operator<(const Data & other);
+    bool operator<(const Data & other) const;
     unsigned long long key1;
     unsigned long long key2;
     std::string key3;
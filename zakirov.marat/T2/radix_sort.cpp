@@ -0,0 +1,208 @@
+#include "radix_sort.hpp"
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <type_traits>
+
+namespace
+{
+  using key1_t = decltype(zakirov::Data::key1);
+  using key2_t = decltype(zakirov::Data::key2);
+
+  constexpr size_t radix_bits = 11;
+  constexpr size_t radix = 1 << radix_bits;
+  constexpr size_t insertion_threshold = 256;
+
+  template< class T >
+  using is_radix_key = std::integral_constant< bool, std::is_integral< T >::value && !std::is_same< T, bool >::value
+      && (sizeof(T) <= sizeof(unsigned long long)) >;
+
+  template< class T >
+  unsigned long long to_radix_key(T value)
+  {
+    using unsigned_t = typename std::make_unsigned< T >::type;
+    unsigned long long key = static_cast< unsigned_t >(value);
+    if (std::is_signed< T >::value)
+    {
+      key ^= 1ULL << (std::numeric_limits< unsigned_t >::digits - 1);
+    }
+    return key;
+  }
+
+  struct RadixEntry
+  {
+    unsigned long long key1;
+    unsigned long long key2;
+    unsigned long long length;
+    size_t index;
+  };
+
+  template< unsigned long long RadixEntry::*Key >
+  void radix_passes(RadixEntry *& data, RadixEntry *& spare, size_t size, size_t bits)
+  {
+    const size_t passes = (bits + radix_bits - 1) / radix_bits;
+    std::array< std::array< size_t, radix >, (std::numeric_limits< unsigned long long >::digits + radix_bits - 1) / radix_bits > counts{};
+    for (size_t i = 0; i < size; ++i)
+    {
+      for (size_t pass = 0; pass < passes; ++pass)
+      {
+        ++counts[pass][(data[i].*Key >> (pass * radix_bits)) & (radix - 1)];
+      }
+    }
+    for (size_t pass = 0; pass < passes; ++pass)
+    {
+      std::array< size_t, radix > & offsets = counts[pass];
+      if (std::find(offsets.begin(), offsets.end(), size) != offsets.end())
+      {
+        continue;
+      }
+      size_t offset = 0;
+      for (size_t & count: offsets)
+      {
+        size_t current = count;
+        count = offset;
+        offset += current;
+      }
+      const size_t shift = pass * radix_bits;
+      for (size_t i = 0; i < size; ++i)
+      {
+        spare[offsets[(data[i].*Key >> shift) & (radix - 1)]++] = data[i];
+      }
+      std::swap(data, spare);
+    }
+  }
+
+  bool entry_less(const RadixEntry & lhs, const RadixEntry & rhs)
+  {
+    if (lhs.key1 != rhs.key1)
+    {
+      return lhs.key1 < rhs.key1;
+    }
+    else if (lhs.key2 != rhs.key2)
+    {
+      return lhs.key2 < rhs.key2;
+    }
+    return lhs.length < rhs.length;
+  }
+
+  void insertion_sort(RadixEntry * first, size_t size)
+  {
+    for (size_t i = 1; i < size; ++i)
+    {
+      RadixEntry current = first[i];
+      size_t j = i;
+      for (; j > 0 && entry_less(current, first[j - 1]); --j)
+      {
+        first[j] = first[j - 1];
+      }
+      first[j] = current;
+    }
+  }
+
+  size_t bit_width(unsigned long long value)
+  {
+    size_t width = 0;
+    for (; value != 0; value >>= 1)
+    {
+      ++width;
+    }
+    return width;
+  }
+
+  void lsd_sort(RadixEntry * first, RadixEntry * spare, size_t size, size_t key1_bits)
+  {
+    if (size <= insertion_threshold)
+    {
+      insertion_sort(first, size);
+      return;
+    }
+    RadixEntry * data = first;
+    radix_passes< &RadixEntry::length >(data, spare, size, std::numeric_limits< unsigned long long >::digits);
+    radix_passes< &RadixEntry::key2 >(data, spare, size, std::numeric_limits< unsigned long long >::digits);
+    radix_passes< &RadixEntry::key1 >(data, spare, size, key1_bits);
+    if (data != first)
+    {
+      std::copy(data, data + size, first);
+    }
+  }
+
+  // one most significant digit pass over the whole array, so that the remaining
+  // passes run over buckets small enough to stay in cache
+  void radix_sort(std::vector< RadixEntry > & entries)
+  {
+    unsigned long long spread = 0;
+    for (const RadixEntry & entry: entries)
+    {
+      spread |= entry.key1 ^ entries.front().key1;
+    }
+    const size_t shift = std::max(bit_width(spread), radix_bits) - radix_bits;
+    std::vector< RadixEntry > buffer(entries.size());
+    std::array< size_t, radix + 1 > bounds{};
+    for (const RadixEntry & entry: entries)
+    {
+      ++bounds[((entry.key1 >> shift) & (radix - 1)) + 1];
+    }
+    for (size_t i = 1; i <= radix; ++i)
+    {
+      bounds[i] += bounds[i - 1];
+    }
+    std::array< size_t, radix + 1 > offsets = bounds;
+    for (const RadixEntry & entry: entries)
+    {
+      buffer[offsets[(entry.key1 >> shift) & (radix - 1)]++] = entry;
+    }
+    for (size_t i = 0; i < radix; ++i)
+    {
+      if (bounds[i + 1] - bounds[i] > 1)
+      {
+        lsd_sort(buffer.data() + bounds[i], entries.data() + bounds[i], bounds[i + 1] - bounds[i], shift);
+      }
+    }
+    entries.swap(buffer);
+  }
+
+  void radix_sort(std::vector< zakirov::Data > & array)
+  {
+    std::vector< RadixEntry > entries;
+    entries.reserve(array.size());
+    for (size_t i = 0; i < array.size(); ++i)
+    {
+      entries.push_back({to_radix_key(array[i].key1), to_radix_key(array[i].key2), array[i].key3.size(), i});
+    }
+    if (!entries.empty())
+    {
+      radix_sort(entries);
+    }
+
+    std::vector< zakirov::Data > sorted;
+    sorted.reserve(array.size());
+    for (const RadixEntry & entry: entries)
+    {
+      sorted.push_back(std::move(array[entry.index]));
+    }
+    array.swap(sorted);
+  }
+
+  template< bool UseRadix >
+  struct DataSorter
+  {
+    static void sort(std::vector< zakirov::Data > & array)
+    {
+      std::stable_sort(array.begin(), array.end());
+    }
+  };
+
+  template<>
+  struct DataSorter< true >
+  {
+    static void sort(std::vector< zakirov::Data > & array)
+    {
+      radix_sort(array);
+    }
+  };
+}
+
+void zakirov::sort_data(std::vector< Data > & array)
+{
+  DataSorter< is_radix_key< key1_t >::value && is_radix_key< key2_t >::value >::sort(array);
+}
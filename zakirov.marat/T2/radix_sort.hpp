@@ -0,0 +1,11 @@
+#ifndef RADIX_SORT_HPP
+#define RADIX_SORT_HPP
+#include <vector>
+#include "processing_structures.hpp"
+
+namespace zakirov
+{
+  void sort_data(std::vector< Data > & array);
+}
+
+#endif